@@ -0,0 +1,288 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        compressedtokenstream.cpp
+ *
+ * \brief       Defines the methods of the CompressedTokenStream class.
+ */
+#include "compressedtokenstream.h"
+#include "token.h"
+#include "tokenlist.h"
+
+/// The flags encoded below a token's type number.
+#define TOKEN_LEADING_SPACE     1
+#define TOKEN_NEW_LINE          2
+#define TOKEN_FLAG_BITS         2
+
+/*!
+ * \brief   Instantiates an empty stream.
+ */
+CompressedTokenStream::CompressedTokenStream()
+    :m_Length(0), m_LastLexeme(0), m_LastLine(0)
+{
+}
+
+/*!
+ * \brief   Instantiates a stream by encoding every token of a list.
+ * \param tokens    The tokens to encode. The list is unchanged.
+ */
+CompressedTokenStream::CompressedTokenStream(const TokenList &tokens)
+    :m_Length(0), m_LastLexeme(0), m_LastLine(0)
+{
+    m_Bytes.reserve(tokens.length() * 2);
+    for (TokenList::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+        append(**it);
+}
+
+/*!
+ * \brief   Encodes a token at the end of the stream.
+ * \param token The token to encode.
+ */
+void CompressedTokenStream::append(const Token &token)
+{
+    // Start a new block, and its sync point, with fresh differences
+    if (m_Length % TOKEN_BLOCK_SIZE == 0)
+    {
+        m_SyncPoints.push_back((unsigned)m_Bytes.size());
+        m_LastLexeme = 0;
+        m_LastLine = 0;
+    }
+
+    // A frozen stream numbers its strings again to go on appending
+    if (m_TypeNumbers.size() != m_Types.size())
+        for (size_t i = 0; i < m_Types.size(); i++)
+            m_TypeNumbers[m_Types[i]] = (int)i;
+    if (m_LexemeNumbers.size() != m_Lexemes.size())
+        for (size_t i = 0; i < m_Lexemes.size(); i++)
+            m_LexemeNumbers[m_Lexemes[i]] = (int)i;
+
+    int type = intern(token.type(), m_Types, m_TypeNumbers);
+    int lexeme = intern(token.lexeme(), m_Lexemes, m_LexemeNumbers);
+    int difference = lexeme - m_LastLexeme;
+    int lines = token.line() - m_LastLine;
+
+    unsigned flags = (token.leadingSpace() ? TOKEN_LEADING_SPACE : 0) |
+                     (lines ? TOKEN_NEW_LINE : 0);
+    encode(((unsigned)type << TOKEN_FLAG_BITS) | flags);
+    encode(((unsigned)difference << 1) ^ (unsigned)(difference >> 31));
+    if (lines)
+        encode(((unsigned)lines << 1) ^ (unsigned)(lines >> 31));
+
+    m_LastLexeme = lexeme;
+    m_LastLine = token.line();
+    m_Length++;
+}
+
+/*!
+ * \brief   Gets the number of tokens in the stream.
+ * \return  The length of the stream.
+ */
+int CompressedTokenStream::length() const
+{
+    return m_Length;
+}
+
+/*!
+ * \brief   Drops the tables numbering the distinct strings, which only
+ *          appending needs, and any spare capacity of the encoding. Appending
+ *          afterwards builds the tables again.
+ */
+void CompressedTokenStream::freeze()
+{
+    std::unordered_map<std::string, int>().swap(m_TypeNumbers);
+    std::unordered_map<std::string, int>().swap(m_LexemeNumbers);
+    m_Bytes.shrink_to_fit();
+    m_SyncPoints.shrink_to_fit();
+}
+
+/*!
+ * \brief   Estimates the memory held by the stream.
+ * \return  The size in bytes of the encoding, the sync points, the distinct
+ *          strings and the tables numbering them, until the stream is frozen.
+ */
+size_t CompressedTokenStream::memoryUsage() const
+{
+    size_t bytes = m_Bytes.capacity() + m_SyncPoints.capacity() * sizeof(unsigned);
+    for (size_t i = 0; i < m_Types.size(); i++)
+        bytes += sizeof(std::string) + m_Types[i].capacity();
+    for (size_t i = 0; i < m_Lexemes.size(); i++)
+        bytes += sizeof(std::string) + m_Lexemes[i].capacity();
+    return bytes + memoryUsage(m_TypeNumbers) + memoryUsage(m_LexemeNumbers);
+}
+
+/*!
+ * \brief   Gets an iterator at any token, decoding from its block's sync point.
+ * \param index The index of the token.
+ * \return  An iterator at \p index, or end() if \p index is out of range.
+ */
+CompressedTokenStream::iterator CompressedTokenStream::at(int index) const
+{
+    if (index < 0 || index >= m_Length)
+        return end();
+
+    iterator it(this, index - index % TOKEN_BLOCK_SIZE);
+    while (it.m_Index < index)
+        ++it;
+    return it;
+}
+
+/// Gets an iterator at the first token.
+CompressedTokenStream::iterator CompressedTokenStream::begin() const
+{
+    return iterator(this, 0);
+}
+
+/// Gets an iterator past the last token.
+CompressedTokenStream::iterator CompressedTokenStream::end() const
+{
+    return iterator(this, m_Length);
+}
+
+/*!
+ * \brief   Decodes every token, appending copies to a token list.
+ * \param tokens    The list to append to. It owns the copies.
+ */
+void CompressedTokenStream::copyTo(TokenList &tokens) const
+{
+    for (iterator it = begin(); it != end(); ++it)
+        tokens.add(it.token());
+}
+
+/*!
+ * \brief   Finds or adds a string in a table of distinct strings.
+ * \param string    The string to number.
+ * \param table     The strings, by number.
+ * \param numbers   The numbers, by string.
+ * \return  The number of \p string.
+ */
+int CompressedTokenStream::intern(const std::string &string,
+                                  std::vector<std::string> &table,
+                                  std::unordered_map<std::string, int> &numbers)
+{
+    std::unordered_map<std::string, int>::iterator it = numbers.find(string);
+    if (it != numbers.end())
+        return it->second;
+
+    int number = (int)table.size();
+    table.push_back(string);
+    numbers[string] = number;
+    return number;
+}
+
+/*!
+ * \brief   Estimates the memory held by a table numbering strings.
+ * \param   numbers The table.
+ * \return  The size in bytes of the buckets and of each node: its key, its
+ *          number and the link to the next node.
+ */
+size_t CompressedTokenStream::memoryUsage(
+    const std::unordered_map<std::string, int> &numbers)
+{
+    size_t bytes = numbers.bucket_count() * sizeof(void*);
+    for (std::unordered_map<std::string, int>::const_iterator it =
+             numbers.begin(); it != numbers.end(); ++it)
+        bytes += sizeof(void*) + sizeof(*it) + it->first.capacity();
+    return bytes;
+}
+
+/*!
+ * \brief   Appends a value as a varint: seven bits per byte, low bits first,
+ *          with the high bit set on every byte but the last.
+ * \param value The value to encode.
+ */
+void CompressedTokenStream::encode(unsigned value)
+{
+    while (value >= 0x80)
+    {
+        m_Bytes.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    m_Bytes.push_back((unsigned char)value);
+}
+
+/*!
+ * \brief   Reads a varint.
+ * \param offset    The offset of the varint; advanced past it.
+ * \return  The decoded value.
+ */
+unsigned CompressedTokenStream::decode(size_t &offset) const
+{
+    unsigned value = 0;
+    int shift = 0;
+    unsigned char byte;
+    do
+    {
+        byte = m_Bytes[offset++];
+        value |= (unsigned)(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+
+/*!
+ * \brief   Instantiates an iterator at the first token of a block, or the end.
+ * \param stream    The stream to decode.
+ * \param index     The index of a block's first token, or the stream length.
+ */
+CompressedTokenStream::iterator::iterator(const CompressedTokenStream *stream,
+                                          int index)
+    :m_pStream(stream), m_Index(index), m_Offset(0), m_Lexeme(0), m_Type(0),
+     m_Line(0), m_LeadingSpace(false)
+{
+    if (index < stream->m_Length)
+    {
+        m_Offset = stream->m_SyncPoints[index / TOKEN_BLOCK_SIZE];
+        decode();
+    }
+}
+
+/*!
+ * \brief   Creates a token equal to the current one.
+ * \return  A new token owned by the caller.
+ */
+Token* CompressedTokenStream::iterator::token() const
+{
+    Token *token = new Token(lexeme(), type(), m_Line);
+    token->setLeadingSpace(m_LeadingSpace);
+    return token;
+}
+
+/*!
+ * \brief   Advances to, and decodes, the next token.
+ * \return  This iterator.
+ */
+CompressedTokenStream::iterator& CompressedTokenStream::iterator::operator++()
+{
+    if (++m_Index < m_pStream->m_Length)
+    {
+        if (m_Index % TOKEN_BLOCK_SIZE == 0)
+        {
+            m_Lexeme = 0;
+            m_Line = 0;
+        }
+        decode();
+    }
+    return *this;
+}
+
+/*!
+ * \brief   Decodes the token whose encoding starts at m_Offset.
+ */
+void CompressedTokenStream::iterator::decode()
+{
+    unsigned type = m_pStream->decode(m_Offset);
+    m_Type = (int)(type >> TOKEN_FLAG_BITS);
+    m_LeadingSpace = (type & TOKEN_LEADING_SPACE) != 0;
+
+    unsigned zigzag = m_pStream->decode(m_Offset);
+    m_Lexeme += (int)(zigzag >> 1) ^ -(int)(zigzag & 1);
+
+    if (type & TOKEN_NEW_LINE)
+    {
+        zigzag = m_pStream->decode(m_Offset);
+        m_Line += (int)(zigzag >> 1) ^ -(int)(zigzag & 1);
+    }
+}
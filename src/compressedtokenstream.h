@@ -0,0 +1,174 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        compressedtokenstream.h
+ *
+ * \brief       Declares the structure of the CompressedTokenStream class.
+ */
+#ifndef COMPRESSEDTOKENSTREAM_H
+#define COMPRESSEDTOKENSTREAM_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Token;
+class TokenList;
+
+/// The number of tokens encoded between two sync points.
+#define TOKEN_BLOCK_SIZE    64
+
+/*!
+ * \brief   The CompressedTokenStream class is a compact, read-only copy of a
+ *          token list.
+ *
+ * Every distinct type and lexeme is stored once. Each token is then a varint
+ * of its type number and two flags, followed by a zigzag varint of the
+ * difference between its lexeme number and the previous token's. The flags
+ * tell whether whitespace came before the token and whether its line differs
+ * from the previous token's, in which case a zigzag varint of the difference
+ * follows. Most tokens take two bytes. Every TOKEN_BLOCK_SIZE tokens the
+ * differences restart from zero and the byte offset is recorded, so any token
+ * can be reached by jumping to its block and decoding at most a block's worth
+ * of tokens.
+ */
+class CompressedTokenStream
+{
+public:
+    /*!
+     * \brief   The iterator class decodes the stream one token at a time.
+     */
+    class iterator
+    {
+    public:
+        iterator()
+            :m_pStream(0), m_Index(0), m_Offset(0), m_Lexeme(0), m_Type(0),
+             m_Line(0), m_LeadingSpace(false) {}
+
+        /// The type of the current token.
+        const std::string &type() const { return m_pStream->m_Types[m_Type]; }
+
+        /// The lexeme of the current token.
+        const std::string &lexeme() const { return m_pStream->m_Lexemes[m_Lexeme]; }
+
+        /// The line of the current token, or 0 if it is not known.
+        int line() const { return m_Line; }
+
+        /// Whether whitespace or a comment came before the current token.
+        bool leadingSpace() const { return m_LeadingSpace; }
+
+        /// The index of the current token within the stream.
+        int index() const { return m_Index; }
+
+        /// Creates a Token holding the current token, owned by the caller.
+        Token *token() const;
+
+        iterator& operator++();
+
+        bool operator==(const iterator &b) const { return m_Index == b.m_Index; }
+        bool operator!=(const iterator &b) const { return m_Index != b.m_Index; }
+
+    private:
+        friend class CompressedTokenStream;
+
+        iterator(const CompressedTokenStream *stream, int index);
+
+        /// Decodes the token at m_Offset, unless past the end.
+        void decode();
+
+        /// The stream being decoded.
+        const CompressedTokenStream *m_pStream;
+
+        /// The index of the current token.
+        int m_Index;
+
+        /// The byte offset of the next token's encoding.
+        size_t m_Offset;
+
+        /// The lexeme number of the current token.
+        int m_Lexeme;
+
+        /// The type number of the current token.
+        int m_Type;
+
+        /// The line of the current token.
+        int m_Line;
+
+        /// Whether whitespace came before the current token.
+        bool m_LeadingSpace;
+    };
+
+    /// Creates an empty stream.
+    CompressedTokenStream();
+
+    /// Creates a stream holding the tokens of \p tokens.
+    CompressedTokenStream(const TokenList &tokens);
+
+    /// Appends a token to the end of the stream.
+    void append(const Token &token);
+
+    /// Returns the number of tokens in the stream.
+    int length() const;
+
+    /// Drops the tables used while appending, once the stream is complete.
+    void freeze();
+
+    /// Returns the approximate number of bytes the stream occupies.
+    size_t memoryUsage() const;
+
+    /// Returns an iterator at token \p index.
+    iterator at(int index) const;
+
+    iterator begin() const;
+    iterator end() const;
+
+    /// Appends a copy of every token in the stream to \p tokens.
+    void copyTo(TokenList &tokens) const;
+
+private:
+    /// Gets the number for \p string in \p table, adding it if new.
+    static int intern(const std::string &string, std::vector<std::string> &table,
+                      std::unordered_map<std::string, int> &numbers);
+
+    /// Returns the approximate number of bytes held by \p numbers.
+    static size_t memoryUsage(const std::unordered_map<std::string, int> &numbers);
+
+    /// Appends \p value to the encoding as a varint.
+    void encode(unsigned value);
+
+    /// Reads a varint from the encoding at \p offset, advancing it.
+    unsigned decode(size_t &offset) const;
+
+    /// The encoded tokens.
+    std::vector<unsigned char> m_Bytes;
+
+    /// The byte offset of the first token of each block.
+    std::vector<unsigned> m_SyncPoints;
+
+    /// Distinct token types, by number.
+    std::vector<std::string> m_Types;
+
+    /// Distinct lexemes, by number.
+    std::vector<std::string> m_Lexemes;
+
+    /// Numbers of the distinct token types, used while encoding, and empty
+    /// once the stream is frozen.
+    std::unordered_map<std::string, int> m_TypeNumbers;
+
+    /// Numbers of the distinct lexemes, used while encoding, and empty once
+    /// the stream is frozen.
+    std::unordered_map<std::string, int> m_LexemeNumbers;
+
+    /// The number of tokens encoded.
+    int m_Length;
+
+    /// The lexeme number of the last token encoded.
+    int m_LastLexeme;
+
+    /// The line of the last token encoded.
+    int m_LastLine;
+};
+
+#endif // COMPRESSEDTOKENSTREAM_H
@@ -0,0 +1,143 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        epochreclaimer.cpp
+ *
+ * \brief       Defines the methods of the EpochReclaimer class.
+ */
+#include "epochreclaimer.h"
+#include <atomic>
+#include <thread>
+
+/*!
+ * \brief   The ReaderRecord struct publishes the epoch a thread's outermost
+ *          read section began in. Records are never freed; a record whose
+ *          thread has exited is claimed by the next new reader thread.
+ */
+struct ReaderRecord
+{
+    /// The epoch the thread's read section began in, or 0 when not reading.
+    std::atomic<unsigned long> m_Epoch;
+
+    /// Whether a live thread owns the record.
+    std::atomic<bool> m_InUse;
+
+    /// The next record in the list of all records.
+    ReaderRecord *m_pNextRecord;
+};
+
+/*!
+ * \brief   The ThreadReader struct is a thread's handle on its record. It
+ *          gives the record up when the thread exits.
+ */
+struct ThreadReader
+{
+    ~ThreadReader()
+    {
+        if (m_pRecord)
+            m_pRecord->m_InUse.store(false, std::memory_order_release);
+    }
+
+    /// The thread's record, claimed on its first read section.
+    ReaderRecord *m_pRecord;
+
+    /// The number of read sections the thread is nested in.
+    int m_Depth;
+};
+
+/// The current epoch; advanced by every synchronize().
+static std::atomic<unsigned long> s_Epoch(1);
+
+/// The list of every reader record.
+static std::atomic<ReaderRecord*> s_pFirstRecord(0);
+
+/// The calling thread's handle on its record.
+static thread_local ThreadReader t_Reader = { 0, 0 };
+
+/*!
+ * \brief   Claims a record for the calling thread, reusing one left by an
+ *          exited thread or else pushing a new one onto the list.
+ * \return  A record owned by the calling thread.
+ */
+static ReaderRecord *claimRecord()
+{
+    ReaderRecord *record = s_pFirstRecord.load(std::memory_order_acquire);
+    for (; record; record = record->m_pNextRecord)
+    {
+        bool inUse = false;
+        if (!record->m_InUse.load(std::memory_order_relaxed) &&
+            record->m_InUse.compare_exchange_strong(inUse, true))
+            return record;
+    }
+
+    record = new ReaderRecord;
+    record->m_Epoch.store(0, std::memory_order_relaxed);
+    record->m_InUse.store(true, std::memory_order_relaxed);
+    record->m_pNextRecord = s_pFirstRecord.load(std::memory_order_relaxed);
+    while (!s_pFirstRecord.compare_exchange_weak(record->m_pNextRecord, record,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed))
+        ;
+    return record;
+}
+
+/*!
+ * \brief   Begins a read section, unless the thread is already in one.
+ *
+ * The fence orders the published epoch before every read the section makes,
+ * pairing with the fence in synchronize().
+ */
+EpochReclaimer::ReadSection::ReadSection()
+{
+    ThreadReader &reader = t_Reader;
+    if (reader.m_Depth++)
+        return;
+
+    if (!reader.m_pRecord)
+        reader.m_pRecord = claimRecord();
+    reader.m_pRecord->m_Epoch.store(s_Epoch.load(std::memory_order_acquire),
+                                    std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+/*!
+ * \brief   Ends a read section. Ending the thread's outermost section clears
+ *          its epoch.
+ */
+EpochReclaimer::ReadSection::~ReadSection()
+{
+    ThreadReader &reader = t_Reader;
+    if (--reader.m_Depth)
+        return;
+
+    reader.m_pRecord->m_Epoch.store(0, std::memory_order_release);
+}
+
+/*!
+ * \brief   Advances the epoch, then waits for every reader still in an older
+ *          epoch to leave its read section.
+ *
+ * A read section that began in the new epoch started after the memory was
+ * unpublished, so it cannot reach it. The caller must not be inside a read
+ * section itself.
+ */
+void EpochReclaimer::synchronize()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    unsigned long epoch = s_Epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+    ReaderRecord *record = s_pFirstRecord.load(std::memory_order_acquire);
+    for (; record; record = record->m_pNextRecord)
+    {
+        for (;;)
+        {
+            unsigned long readerEpoch =
+                record->m_Epoch.load(std::memory_order_acquire);
+            if (!readerEpoch || readerEpoch >= epoch)
+                break;
+            std::this_thread::yield();
+        }
+    }
+}
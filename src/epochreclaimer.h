@@ -0,0 +1,45 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        epochreclaimer.h
+ *
+ * \brief       Declares the structure of the EpochReclaimer class.
+ */
+#ifndef EPOCHRECLAIMER_H
+#define EPOCHRECLAIMER_H
+
+/*!
+ * \brief   The EpochReclaimer class lets a writer wait until no reader can
+ *          still see memory it has unpublished, so the memory can be freed.
+ *
+ * Readers bracket their accesses with a ReadSection, which costs two stores
+ * and never waits. A writer first makes the memory unreachable, then calls
+ * synchronize(), which returns once every read section that might have
+ * reached the memory has ended. Read sections nest.
+ */
+class EpochReclaimer
+{
+public:
+    /*!
+     * \brief   The ReadSection class marks the calling thread as reading for
+     *          as long as it is in scope.
+     */
+    class ReadSection
+    {
+    public:
+        ReadSection();
+        ~ReadSection();
+
+    private:
+        // Sections are tied to a thread's stack and are not copyable
+        ReadSection(const ReadSection&);
+        ReadSection& operator=(const ReadSection&);
+    };
+
+    /// Waits for every read section begun before the call to end.
+    static void synchronize();
+};
+
+#endif//EPOCHRECLAIMER_H
@@ -0,0 +1,229 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        includecache.cpp
+ *
+ * \brief       Defines the methods of the IncludeCache class.
+ */
+#include "includecache.h"
+#include "lex.h"
+#include "token.h"
+#include "tokenlist.h"
+#include "tokensequence.h"
+#include <functional>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+/// The resolution to which modification times are kept.
+static const long long NANOSECONDS_PER_SECOND = 1000000000LL;
+
+/*!
+ * \brief   Instantiates an empty cache.
+ */
+IncludeCache::IncludeCache()
+    :m_LexCount(0)
+{
+}
+
+/*!
+ * \brief   Destroys the cache. Tokens still referred to by an includer live on
+ *          until it lets go of them.
+ */
+IncludeCache::~IncludeCache()
+{
+    clear();
+}
+
+/*!
+ * \brief   Looks up a file with a single stat of the path as given.
+ * \param   path    The path of the file.
+ * \param   file    Receives the file's path, identity and state.
+ * \return  true if the file exists and is a regular file, otherwise false.
+ *
+ * Windows reports no inode, so there a file is identified by its drive and a
+ * hash of its full path instead, which is resolved without touching the disk.
+ * It also reports modification times in whole seconds only, where POSIX
+ * systems give nanoseconds, so that a file rewritten within the second it was
+ * lexed is still seen to change.
+ */
+bool IncludeCache::statFile(const char *path, FileInfo &file)
+{
+#if defined(_MSC_VER)
+    char resolved[_MAX_PATH];
+    struct _stat status;
+    if (!_fullpath(resolved, path, _MAX_PATH) || _stat(path, &status) != 0)
+        return false;
+#else
+    struct stat status;
+    if (stat(path, &status) != 0)
+        return false;
+#endif
+
+    if ((status.st_mode & S_IFMT) != S_IFREG)
+        return false;
+
+    file.m_Path = path;
+    file.m_Id.m_Device = (unsigned long long)status.st_dev;
+#if defined(_MSC_VER)
+    file.m_Id.m_Inode = std::hash<std::string>()(std::string(resolved));
+#else
+    file.m_Id.m_Inode = (unsigned long long)status.st_ino;
+#endif
+#if defined(_MSC_VER)
+    file.m_ModifiedTime = (long long)status.st_mtime * NANOSECONDS_PER_SECOND;
+#elif defined(__APPLE__)
+    file.m_ModifiedTime =
+        (long long)status.st_mtimespec.tv_sec * NANOSECONDS_PER_SECOND +
+        status.st_mtimespec.tv_nsec;
+#else
+    file.m_ModifiedTime =
+        (long long)status.st_mtim.tv_sec * NANOSECONDS_PER_SECOND +
+        status.st_mtim.tv_nsec;
+#endif
+    file.m_Size = (long long)status.st_size;
+    return true;
+}
+
+/*!
+ * \brief   Gets the raw tokens of a file.
+ * \param   path        The path of the file.
+ * \param   guard       Receives the macro guarding the file, or an empty string
+ *                      if it has none. May be NULL.
+ * \return  The file's tokens, with a reference added for the caller to
+ *          release, or NULL if the file cannot be found.
+ */
+TokenBuffer *IncludeCache::tokens(const char *path, std::string *guard)
+{
+    FileInfo file;
+    if (!path || !statFile(path, file))
+        return 0;
+
+    return tokens(file, guard);
+}
+
+/*!
+ * \brief   Gets the raw tokens of a file.
+ * \param   file        The file, as found by statFile().
+ * \param   guard       Receives the macro guarding the file, or an empty string
+ *                      if it has none. May be NULL.
+ * \return  The file's tokens, with a reference added for the caller to
+ *          release.
+ *
+ * The file is lexed if it is not cached, or has changed since it was. Lexing
+ * is done without holding the cache, so other files may be looked up in the
+ * meantime; should two threads lex the same file, the first to finish wins.
+ */
+TokenBuffer *IncludeCache::tokens(const FileInfo &file, std::string *guard)
+{
+    Entry entry;
+    entry.m_ModifiedTime = file.m_ModifiedTime;
+    entry.m_Size = file.m_Size;
+    entry.m_pTokens = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::map<FileId, Entry>::iterator cached = m_Entries.find(file.m_Id);
+        if (cached != m_Entries.end() &&
+            cached->second.m_ModifiedTime == entry.m_ModifiedTime &&
+            cached->second.m_Size == entry.m_Size)
+        {
+            if (guard)
+                *guard = cached->second.m_Guard;
+            cached->second.m_pTokens->addRef();
+            return cached->second.m_pTokens;
+        }
+    }
+
+    // Lex the file as it was when stat'ed; a later change shows on the next use
+    Lex lex;
+    TokenList *tokens = lex.tokenizeFile(file.m_Path.c_str());
+    entry.m_pTokens = new TokenBuffer(*tokens);
+    entry.m_Guard = findGuard(*entry.m_pTokens);
+    delete tokens;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_LexCount++;
+
+    std::map<FileId, Entry>::iterator cached = m_Entries.find(file.m_Id);
+    if (cached == m_Entries.end())
+    {
+        m_Entries[file.m_Id] = entry;
+    }
+    else if (cached->second.m_ModifiedTime == entry.m_ModifiedTime &&
+             cached->second.m_Size == entry.m_Size)
+    {
+        // Another thread cached the same file first
+        entry.m_pTokens->release();
+        entry = cached->second;
+    }
+    else
+    {
+        cached->second.m_pTokens->release();
+        cached->second = entry;
+    }
+
+    if (guard)
+        *guard = entry.m_Guard;
+    entry.m_pTokens->addRef();
+    return entry.m_pTokens;
+}
+
+/*!
+ * \brief   Drops every cached file, so that each is lexed again on its next
+ *          use.
+ */
+void IncludeCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (std::map<FileId, Entry>::iterator it = m_Entries.begin();
+         it != m_Entries.end(); ++it)
+        it->second.m_pTokens->release();
+    m_Entries.clear();
+}
+
+/// Returns the number of files cached.
+int IncludeCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return (int)m_Entries.size();
+}
+
+/// Returns the number of times a file was lexed rather than found cached.
+unsigned long IncludeCache::lexCount() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_LexCount;
+}
+
+/*!
+ * \brief   Finds the include guard of a file.
+ * \param   tokens  The raw tokens of the file.
+ * \return  X, if the file is #ifndef X, then anything, then the #endif
+ *          matching the #ifndef as its last token; otherwise an empty string.
+ */
+std::string IncludeCache::findGuard(const TokenBuffer &tokens)
+{
+    int length = tokens.length();
+    if (length < 3 || tokens.token(0)->lexeme() != "#ifndef" ||
+        tokens.token(1)->type() != "ID")
+        return std::string();
+
+    // The #endif closing the #ifndef must end the file
+    int depth = 0;
+    for (int i = 0; i < length; i++)
+    {
+        Token *token = tokens.token(i);
+        if (token->type() != "PREPROCESSOR")
+            continue;
+
+        std::string directive = token->lexeme();
+        if (directive == "#ifdef" || directive == "#ifndef")
+            depth++;
+        else if (directive == "#endif" && --depth == 0)
+            return i == length - 1 ? tokens.token(1)->lexeme() : std::string();
+    }
+    return std::string();
+}
@@ -0,0 +1,137 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        includecache.h
+ *
+ * \brief       Declares the structure of the IncludeCache class.
+ */
+#ifndef INCLUDECACHE_H
+#define INCLUDECACHE_H
+
+#include <map>
+#include <mutex>
+#include <string>
+
+class TokenBuffer;
+
+/*!
+ * \brief   The FileId struct identifies a file by its device and inode, so
+ *          that every path reaching the file gives the same identity.
+ */
+struct FileId
+{
+    unsigned long long m_Device;
+    unsigned long long m_Inode;
+
+    bool operator==(const FileId &b) const
+    {
+        return m_Device == b.m_Device && m_Inode == b.m_Inode;
+    }
+    bool operator<(const FileId &b) const
+    {
+        return m_Device < b.m_Device ||
+               (m_Device == b.m_Device && m_Inode < b.m_Inode);
+    }
+};
+
+/*!
+ * \brief   The FileInfo struct holds what one stat of a file tells: where it
+ *          is, what it is, and what state it is in.
+ */
+struct FileInfo
+{
+    /// The path the file was looked up by.
+    std::string m_Path;
+
+    /// The identity of the file.
+    FileId m_Id;
+
+    /// The modification time of the file, in nanoseconds.
+    long long m_ModifiedTime;
+
+    /// The size of the file, in bytes.
+    long long m_Size;
+};
+
+/*!
+ * \brief   The IncludeCache class keeps the raw tokens of every file lexed
+ *          for an #include, so that a file included many times is read and
+ *          lexed only once.
+ *
+ * Files are keyed by their identity, so every path reaching a file shares one
+ * entry, and an entry is only reused while the file's modification time and
+ * size are unchanged. The tokens are those the lexer produced, before
+ * any directive was acted on, so one entry serves every includer whatever
+ * macros it has defined.
+ *
+ * A file wrapped whole in #ifndef X ... #endif has X noted as its include
+ * guard, as the file is lexed. While X is defined the file yields no tokens,
+ * so an includer may skip it without reading its tokens at all.
+ *
+ * A cache may be shared by several preprocessors, on several threads, such as
+ * those of the translation units of one build.
+ */
+class IncludeCache
+{
+public:
+    /// Creates an empty cache.
+    IncludeCache();
+
+    /// Drops the cache's references to its tokens.
+    ~IncludeCache();
+
+    /// Looks up the file at \p path.
+    static bool statFile(const char *path, FileInfo &file);
+
+    /// Returns the raw tokens of the file at \p path, lexing it if needed.
+    TokenBuffer *tokens(const char *path, std::string *guard = 0);
+
+    /// Returns the raw tokens of a file already looked up, lexing it if needed.
+    TokenBuffer *tokens(const FileInfo &file, std::string *guard = 0);
+
+    /// Drops every cached file.
+    void clear();
+
+    /// Returns the number of files cached.
+    int size() const;
+
+    /// Returns the number of times a file was lexed rather than found cached.
+    unsigned long lexCount() const;
+
+private:
+    /// A lexed file and the state of the file it was lexed from.
+    struct Entry
+    {
+        /// The modification time of the file, in nanoseconds.
+        long long m_ModifiedTime;
+
+        /// The size of the file, in bytes.
+        long long m_Size;
+
+        /// The file's tokens, of which the cache holds one reference.
+        TokenBuffer *m_pTokens;
+
+        /// The macro guarding the whole file, or empty if there is none.
+        std::string m_Guard;
+    };
+
+    // Caches own their entries and are not copyable
+    IncludeCache(const IncludeCache&);
+    IncludeCache& operator=(const IncludeCache&);
+
+    /// Finds the macro guarding the whole of \p tokens.
+    static std::string findGuard(const TokenBuffer &tokens);
+
+    /// The cached files, by identity.
+    std::map<FileId, Entry> m_Entries;
+
+    /// The number of files lexed.
+    unsigned long m_LexCount;
+
+    /// Guards the entries and the count.
+    mutable std::mutex m_Mutex;
+};
+
+#endif//INCLUDECACHE_H
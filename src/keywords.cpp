@@ -0,0 +1,88 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        keywords.cpp
+ *
+ * \brief       Defines the table of LLC keywords and its perfect hash.
+ */
+#include "keywords.h"
+#include <string.h>
+
+/// The number of slots in the keyword hash table, a power of two.
+#define KEYWORD_SLOTS   16
+
+constexpr SymbolDefinition LLC_KEYWORDS[LLC_KEYWORD_COUNT] =
+{
+    { "bool",   ET_VOID, EU_KEYWORD, 0 },
+    { "break",  ET_VOID, EU_KEYWORD, 0 },
+    { "else",   ET_VOID, EU_KEYWORD, 0 },
+    { "false",  ET_VOID, EU_KEYWORD, 0 },
+    { "if",     ET_VOID, EU_KEYWORD, 0 },
+    { "int",    ET_VOID, EU_KEYWORD, 0 },
+    { "return", ET_VOID, EU_KEYWORD, 0 },
+    { "true",   ET_VOID, EU_KEYWORD, 0 },
+    { "void",   ET_VOID, EU_KEYWORD, 0 },
+    { "while",  ET_VOID, EU_KEYWORD, 0 }
+};
+
+/// The index in LLC_KEYWORDS of the keyword hashed to each slot, or -1.
+static constexpr signed char s_KeywordSlots[KEYWORD_SLOTS] =
+{
+    9, 2, 5, 6, -1, -1, 7, 0, -1, 4, 3, 8, -1, 1, -1, -1
+};
+
+/*!
+ * \brief   Hashes a name of at least one character to its keyword slot.
+ * \param   name    The name to hash.
+ * \param   length  The length of \p name.
+ * \return  The slot of \p name, which no other keyword shares.
+ *
+ * The multipliers were searched for to spread the keywords over the slots
+ * without a collision. Adding a keyword means searching again; the
+ * static_assert below fails until the slots are right.
+ */
+static constexpr unsigned int keywordSlot(const char *name, unsigned int length)
+{
+    return ((unsigned char)name[0] * 5u + (unsigned char)name[1] * 7u + length)
+           & (KEYWORD_SLOTS - 1);
+}
+
+/// Returns the length of \p name, at compile time.
+static constexpr unsigned int keywordLength(const char *name)
+{
+    return *name ? 1 + keywordLength(name + 1) : 0;
+}
+
+/// Returns whether the keywords from \p index on hash to their own slots.
+static constexpr bool keywordSlotsArePerfect(int index)
+{
+    return index == LLC_KEYWORD_COUNT ||
+           (s_KeywordSlots[keywordSlot(LLC_KEYWORDS[index].m_pName,
+                           keywordLength(LLC_KEYWORDS[index].m_pName))]
+                == index &&
+            keywordSlotsArePerfect(index + 1));
+}
+
+static_assert(keywordSlotsArePerfect(0),
+              "the keyword slots do not match the keyword hash");
+
+/*!
+ * \brief   Looks a name up in the keyword table.
+ * \param   name    The name to look up.
+ * \return  Pointer to the keyword named \p name, or NULL if it is not one.
+ *
+ * The name is hashed straight to the one keyword it could be, so a lookup
+ * costs a single string comparison at most.
+ */
+const SymbolDefinition *findKeyword(const char *name)
+{
+    if (!name || !name[0])
+        return 0;
+
+    int index = s_KeywordSlots[keywordSlot(name, strlen(name))];
+    if (index < 0 || strcmp(name, LLC_KEYWORDS[index].m_pName))
+        return 0;
+    return &LLC_KEYWORDS[index];
+}
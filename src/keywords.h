@@ -0,0 +1,29 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        keywords.h
+ *
+ * \brief       Declares the table of LLC keywords.
+ *
+ * The table is a constant built into the binary, so it costs nothing at
+ * startup. It is added to a symbol table in one call to
+ * SymbolTable::addSymbols(), and a name can be checked against it without a
+ * symbol table through findKeyword(), as the lexer does.
+ */
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+#include "symbol.h"
+
+/// The number of LLC keywords.
+#define LLC_KEYWORD_COUNT   10
+
+/// The LLC keywords, sorted by name.
+extern const SymbolDefinition LLC_KEYWORDS[LLC_KEYWORD_COUNT];
+
+/// Returns the keyword named \p name, or NULL if it is not a keyword.
+const SymbolDefinition *findKeyword(const char *name);
+
+#endif//KEYWORDS_H
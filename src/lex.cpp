@@ -8,11 +8,12 @@
  * \brief       Defines the structure of the Lex class.
  */
 #include "lex.h"
+#include "keywords.h"
 #include "token.h"
 #include "tokenlist.h"
-#include "symboltable.h"
 #include <sstream>
 #include <fstream>
+#include <limits>
 
 // For preprocessor #include
 #ifdef _WIN32
@@ -23,12 +24,11 @@
 #endif
 
 /*!
- * \brief Instatiates a new Lex object with a SymbolTable reference.
- * \param symbolTable   Reference to an instantiated symbol table. Doesn't have
- *                      to be populated, but it helps.
+ * \brief Instatiates a new Lex object. Keywords are recognized by findKeyword(),
+ *        so the lexer needs no symbol table.
  */
-Lex::Lex(const SymbolTable &symbolTable)
-    :m_SymbolTable(symbolTable)
+Lex::Lex()
+    :m_pStream(0), m_pFilename(0), m_State(START), m_Line(1), m_Spaced(false)
 {
 }
 
@@ -70,45 +70,78 @@ TokenList *Lex::tokenizeFile(const char *filename)
  * \param filename  Name of the file we may be parsing.
  * \return Pointer to a list of tokens found in the input stream.
  *
- * This function needs a populated symbol table to function correctly. You must
- * populate the table with keywords, if they exist.
+ * Keywords are found in the LLC keyword table, so the symbol table need not
+ * hold them.
  */
 TokenList *Lex::Analyze(std::istream &istream, const char *filename)
 {
-    LEX_STATE state = START;
-    int line = 1; ///Variables to track the current line and column position
-    char ch  = 0; ///Current symbol being parsed by the lexical analyzer
-    //int ret  = 0; ///Return value, 0 for success, anything else for errors
-
-    std::string token; ///Token being parsed
-    std::string expansion; ///#define macro expansion
-    std::string macro; ///#define macro name
-    std::string error; ///Error string
     TokenList *tokens = new TokenList;
 
-    while (istream.get(ch))
+    begin(istream, filename);
+    while (Token *token = nextToken())
+        tokens->add(token);
+
+    return tokens;
+}
+
+/*!
+ * \brief Starts tokenizing an input stream one token at a time.
+ * \param istream   An input stream to tokenize, which must outlive the
+ *                  tokenizing.
+ * \param filename  Name of the file we may be parsing, which must outlive the
+ *                  tokenizing too.
+ *
+ * Any stream being tokenized before is abandoned, along with a partly read
+ * token.
+ */
+void Lex::begin(std::istream &istream, const char *filename)
+{
+    m_pStream = &istream;
+    m_pFilename = filename;
+    m_State = START;
+    m_Line = 1;
+    m_Spaced = false;
+    m_Token.clear();
+    m_Error.clear();
+}
+
+/*!
+ * \brief Reads characters from the stream until they form a token.
+ * \return The next token of the stream, which the caller owns, or NULL once the
+ *         stream is exhausted.
+ *
+ * Only as many characters are read as the token needs, so a stream of any size
+ * is tokenized in constant memory. Errors are reported as they are read.
+ */
+Token *Lex::nextToken()
+{
+    char ch = 0; ///Current symbol being parsed by the lexical analyzer
+
+    while (m_pStream && m_pStream->get(ch))
     {
-        switch (state)
+        Token *result = 0;
+
+        switch (m_State)
         {
 #ifndef START
             case START:
                 ///If the  beginning of a token is a #, it is a preprocessor directive
                 if (ch == '#')
                 {
-                    state = PREPROCESSOR;
-                    token.push_back(ch);
+                    m_State = PREPROCESSOR;
+                    m_Token.push_back(ch);
                 }
                 ///If the beginning of a token is a number, it is a constant
                 else if (isdigit(ch))
                 {
-                    state = CONSTANT;
-                    token.push_back(ch);
+                    m_State = CONSTANT;
+                    m_Token.push_back(ch);
                 }
                 ///If the beginning of a token is a letter, it could be a keyword or identifier
                 else if (isalpha(ch))
                 {
-                    state = KEYWORD_OR_ID;
-                    token.push_back(ch);
+                    m_State = KEYWORD_OR_ID;
+                    m_Token.push_back(ch);
                 }
                 ///The following operator symbols are unambiguous, print immediately
                 else if (ch == '(' ||
@@ -120,69 +153,70 @@ TokenList *Lex::Analyze(std::istream &istream, const char *filename)
                          ch == ';' ||
                          ch == ',')
                 {
-                    tokens->add(new Token(std::string(1, ch), std::string(1, ch)));
+                    result = new Token(std::string(1, ch), std::string(1, ch), m_Line);
                 }
                 else if (ch == '*' ||
                          ch == '%')
                 {
-                    tokens->add(new Token(std::string(1, ch), "MULOP"));
+                    result = new Token(std::string(1, ch), "MULOP", m_Line);
                 }
                 ///The following operator symbols are ambiguous (ex: + or +=)
                 else if (ch == '+')
-                    state = OP_ADD;
+                    m_State = OP_ADD;
                 else if (ch == '-')
-                    state = OP_SUB;
+                    m_State = OP_SUB;
                 else if (ch == '/')
-                    state = OP_DIV;
+                    m_State = OP_DIV;
                 else if (ch == '&')
-                    state = OP_AND;
+                    m_State = OP_AND;
                 else if (ch == '|')
-                    state = OP_OR;
+                    m_State = OP_OR;
                 else if (ch == '<')
-                    state = OP_LEFT;
+                    m_State = OP_LEFT;
                 else if (ch == '>')
-                    state = OP_RIGHT;
+                    m_State = OP_RIGHT;
                 else if (ch == '!')
-                    state = OP_NOT;
+                    m_State = OP_NOT;
                 else if (ch == '=')
-                    state = OP_ASSIGN;
+                    m_State = OP_ASSIGN;
                 else if (ch == '"')
                 {
-                    token.push_back(ch);
-                    state = STRING;
+                    m_Token.push_back(ch);
+                    m_State = STRING;
                 }
                 ///Ignore whitespace, increment col counter, increment line counter on newlines
                 else if (isspace(ch))
                 {
                     if (ch == '\n' || ch == '\r' || ch == '\f')
-                        line++;
+                        m_Line++;
+                    m_Spaced = true;
                 }
                 else
-                    printf("Illegal symbol %c encountered at %s(%i).\n", ch, filename, line);
+                    printf("Illegal symbol %c encountered at %s(%i).\n", ch, m_pFilename, m_Line);
             break;
 #endif
             case STRING:
                 if (ch == '"')
                 {
-                    token.push_back(ch);
-                    tokens->add(new Token(token, "STRING"));
-                    token.clear();
-                    state = START;
+                    m_Token.push_back(ch);
+                    result = new Token(m_Token, "STRING", m_Line);
+                    m_Token.clear();
+                    m_State = START;
                 }
                 else if (isprint(ch))
                 {
-                    token.push_back(ch);
+                    m_Token.push_back(ch);
                     if (ch == '\\')
-                        state = STRING_ESCAPE;
+                        m_State = STRING_ESCAPE;
                 }
                 else
-                    printf("Illegal symbol %c encountered at %s(%i).\n", ch, filename, line);
+                    printf("Illegal symbol %c encountered at %s(%i).\n", ch, m_pFilename, m_Line);
             break;
             case STRING_ESCAPE:
                 if (isprint(ch))
-                    state = STRING;
+                    m_State = STRING;
                 else
-                    printf("Illegal symbol %c encountered at %s(%i).\n", ch, filename, line);
+                    printf("Illegal symbol %c encountered at %s(%i).\n", ch, m_pFilename, m_Line);
             break;
 #ifndef TWO_OR_THREE_PART_OPS
             ///Operator tokens that may or may not be more than one character
@@ -190,57 +224,57 @@ TokenList *Lex::Analyze(std::istream &istream, const char *filename)
             {
                 if (ch == '=')
                 {
-                    tokens->add(new Token("+=", "ADDASSIGN"));
+                    result = new Token("+=", "ADDASSIGN", m_Line);
                 }
                 else
                 {
-                    tokens->add(new Token("+", "ADDOP"));
-                    istream.putback(ch);
+                    result = new Token("+", "ADDOP", m_Line);
+                    m_pStream->putback(ch);
                 }
-                state = START;
+                m_State = START;
             }
             break;
             case OP_SUB:
             {
                 if (ch == '=')
                 {
-                    tokens->add(new Token("-=", "SUBASSIGN"));
+                    result = new Token("-=", "SUBASSIGN", m_Line);
                 }
                 else
                 {
-                    tokens->add(new Token("-", "ADDOP"));
-                    istream.putback(ch);
+                    result = new Token("-", "ADDOP", m_Line);
+                    m_pStream->putback(ch);
                 }
-                state = START;
+                m_State = START;
             }
             break;
             case OP_MUL:
             {
                 if (ch == '=')
                 {
-                    tokens->add(new Token("*=", "MULASSIGN"));
+                    result = new Token("*=", "MULASSIGN", m_Line);
                 }
                 else
                 {
-                    tokens->add(new Token("*", "MULOP"));
-                    istream.putback(ch);
+                    result = new Token("*", "MULOP", m_Line);
+                    m_pStream->putback(ch);
                 }
-                state = START;
+                m_State = START;
             }
             break;
             case OP_DIV:
             {
                 if (ch == '/')
-                    state = COMMENTS_SINGLE_LINE;
+                    m_State = COMMENTS_SINGLE_LINE;
                 else if (ch == '=')
                 {
-                    tokens->add(new Token("/=", "MULASSIGN"));
+                    result = new Token("/=", "MULASSIGN", m_Line);
                 }
                 else
                 {
-                    tokens->add(new Token("/", "MULOP"));
-                    istream.putback(ch);
-                    state = START;
+                    result = new Token("/", "MULOP", m_Line);
+                    m_pStream->putback(ch);
+                    m_State = START;
                 }
             }
             break;
@@ -248,98 +282,98 @@ TokenList *Lex::Analyze(std::istream &istream, const char *filename)
             {
                 if (ch == '=')
                 {
-                    tokens->add(new Token("%=", "MODASSIGN"));
+                    result = new Token("%=", "MODASSIGN", m_Line);
                 }
                 else
                 {
-                    tokens->add(new Token("%", "MULOP"));
-                    istream.putback(ch);
+                    result = new Token("%", "MULOP", m_Line);
+                    m_pStream->putback(ch);
                 }
-                state = START;
+                m_State = START;
             }
             break;
             case OP_AND:
             {
                 if (ch == '&')
                 {
-                    tokens->add(new Token("&&", "LOGICOP"));
+                    result = new Token("&&", "LOGICOP", m_Line);
                 }
                 else
                 {
-                    printf("Encountered illegal token &. %s(%i)\n", filename, line);
-                    istream.putback(ch);
+                    printf("Encountered illegal token &. %s(%i)\n", m_pFilename, m_Line);
+                    m_pStream->putback(ch);
                 }
-                state = START;
+                m_State = START;
             }
             break;
             case OP_OR:
             {
                 if (ch == '|')
                 {
-                    tokens->add(new Token("||", "LOGICOP"));
+                    result = new Token("||", "LOGICOP", m_Line);
                 }
                 else
                 {
-                    printf("Encountered illegal token |. %s(%i)\n", filename, line);
-                    istream.putback(ch);
+                    printf("Encountered illegal token |. %s(%i)\n", m_pFilename, m_Line);
+                    m_pStream->putback(ch);
                 }
-                state = START;
+                m_State = START;
             }
             break;
             case OP_LEFT:
             {
                 if (ch == '=')
                 {
-                    tokens->add(new Token("<=", "RELOP"));
+                    result = new Token("<=", "RELOP", m_Line);
                 }
                 else
                 {
-                    tokens->add(new Token("<", "RELOP"));
-                    istream.putback(ch);
+                    result = new Token("<", "RELOP", m_Line);
+                    m_pStream->putback(ch);
                 }
-                state = START;
+                m_State = START;
             }
             break;
             case OP_RIGHT:
             {
                 if (ch == '=')
                 {
-                    tokens->add(new Token(">=", "RELOP"));
+                    result = new Token(">=", "RELOP", m_Line);
                 }
                 else
                 {
-                    tokens->add(new Token(">", "RELOP"));
-                    istream.putback(ch);
+                    result = new Token(">", "RELOP", m_Line);
+                    m_pStream->putback(ch);
                 }
-                state = START;
+                m_State = START;
             }
             break;
             case OP_NOT:
             {
                 if (ch == '=')
                 {
-                    tokens->add(new Token("!=", "RELOP"));
+                    result = new Token("!=", "RELOP", m_Line);
                 }
                 else
                 {
-                    tokens->add(new Token("!", "UNARYOP"));
-                    istream.putback(ch);
+                    result = new Token("!", "UNARYOP", m_Line);
+                    m_pStream->putback(ch);
                 }
-                state = START;
+                m_State = START;
             }
             break;
             case OP_ASSIGN:
             {
                 if (ch == '=')
                 {
-                    tokens->add(new Token("==", "RELOP"));
+                    result = new Token("==", "RELOP", m_Line);
                 }
                 else
                 {
-                    tokens->add(new Token("=", "ASSIGNOP"));
-                    istream.putback(ch);
+                    result = new Token("=", "ASSIGNOP", m_Line);
+                    m_pStream->putback(ch);
                 }
-                state = START;
+                m_State = START;
             }
             break;
 #endif
@@ -348,8 +382,9 @@ TokenList *Lex::Analyze(std::istream &istream, const char *filename)
             case COMMENTS_SINGLE_LINE:
                 if (ch == '\n')
                 {
-                    line++;
-                    state = START;
+                    m_Line++;
+                    m_Spaced = true;
+                    m_State = START;
                 }
                 break;
 #endif
@@ -357,16 +392,19 @@ TokenList *Lex::Analyze(std::istream &istream, const char *filename)
             ///Found a '#', now we're gonna read the preprocessor directive
             case PREPROCESSOR:
                 if (isalpha(ch))
-                    token.push_back(ch);
+                    m_Token.push_back(ch);
                 else
                 {
-                    if (token == "#define" || token == "#include" ||
-                        token == "#ifdef" || token == "#ifndef" ||
-                        token == "#undef" || token == "#endif")
+                    if (m_Token == "#define" || m_Token == "#include" ||
+                        m_Token == "#ifdef" || m_Token == "#ifndef" ||
+                        m_Token == "#undef" || m_Token == "#endif" ||
+                        m_Token == "#pragma")
                     {
-                        tokens->add(new Token(token, "PREPROCESSOR"));
-                        token.clear();
-                        state = START;
+                        result = new Token(m_Token, "PREPROCESSOR", m_Line);
+                        m_Token.clear();
+                        ///Reanalyze the character ending the directive
+                        m_pStream->putback(ch);
+                        m_State = START;
                     }
                 }
             break;
@@ -376,32 +414,32 @@ TokenList *Lex::Analyze(std::istream &istream, const char *filename)
             case KEYWORD_OR_ID:
                 if (isalpha(ch))
                 {
-                    if (token.length() < MAX_ID_LENGTH)
-                        token.push_back(ch);
+                    if (m_Token.length() < MAX_ID_LENGTH)
+                        m_Token.push_back(ch);
                 }
                 else
                     ///When we get a digit, we're looking at a number
                     if (isdigit(ch))
                     {
-                        token.push_back(ch);
-                        state = ID;
+                        m_Token.push_back(ch);
+                        m_State = ID;
                     }
                     ///If anything else, it's the end of the identifier
                     else
                     {
-                        ///If the token doesn't exist in the symbol table, it's a keyword
-                        if (m_SymbolTable.findSymbol(token.c_str()).isNull())
+                        ///Unless the token is a keyword, it's an identifier.
+                        if (!findKeyword(m_Token.c_str()))
                         {
-                            tokens->add(new Token(token, "ID"));
+                            result = new Token(m_Token, "ID", m_Line);
                         }
                         else
                         {
-                            tokens->add(new Token(token, "KEYWORD"));
+                            result = new Token(m_Token, "KEYWORD", m_Line);
                         }
                         ///Reanalyze the non-alphanumeric
-                        token.clear();
-                        istream.putback(ch);
-                        state = START;
+                        m_Token.clear();
+                        m_pStream->putback(ch);
+                        m_State = START;
                     }
                 break;
             ///Found a number, we know it's an identifier
@@ -409,28 +447,28 @@ TokenList *Lex::Analyze(std::istream &istream, const char *filename)
                 ///The rest of the characters must be digits
                 if (isdigit(ch))
                 {
-                    if (token.length() < MAX_ID_LENGTH)
-                        token.push_back(ch);
+                    if (m_Token.length() < MAX_ID_LENGTH)
+                        m_Token.push_back(ch);
                 }
                 else if (isalpha(ch))
                 {
-                    error = "Letters cannot follow digits in identifier names";
-                    token.push_back(ch);
+                    m_Error = "Letters cannot follow digits in identifier names";
+                    m_Token.push_back(ch);
                 }
                 else
                 {
-                    if (error.length())
+                    if (m_Error.length())
                     {
-                        printf("%s - %s. %s(%i)\n", token.c_str(), error.c_str(), filename, line);
-                        error.clear();
+                        printf("%s - %s. %s(%i)\n", m_Token.c_str(), m_Error.c_str(), m_pFilename, m_Line);
+                        m_Error.clear();
                     }
                     else
                     {
-                        tokens->add(new Token(token, "ID"));
+                        result = new Token(m_Token, "ID", m_Line);
                     }
-                    token.clear();
-                    istream.putback(ch);
-                    state = START;
+                    m_Token.clear();
+                    m_pStream->putback(ch);
+                    m_State = START;
                 }
                 break;
 #endif
@@ -438,46 +476,100 @@ TokenList *Lex::Analyze(std::istream &istream, const char *filename)
             ///Found a number; any following character must be a digit
             case CONSTANT:
                 if (isdigit(ch))
-                    token.push_back(ch);
+                    m_Token.push_back(ch);
                 else if (isalpha(ch))
                 {
-                    error = "Constants cannot contain characters";
-                    token.push_back(ch);
+                    m_Error = "Constants cannot contain characters";
+                    m_Token.push_back(ch);
                 }
                 else
                 {
-                    if (error.length())
+                    if (m_Error.length())
                     {
-                        printf("%s - %s. %s(%i)\n", token.c_str(), error.c_str(), filename, line);
-                        error.clear();
+                        printf("%s - %s. %s(%i)\n", m_Token.c_str(), m_Error.c_str(), m_pFilename, m_Line);
+                        m_Error.clear();
                     }
                     else
                     {
-                        tokens->add(new Token(token, "CONSTANT"));
+                        result = new Token(m_Token, "CONSTANT", m_Line);
                     }
-                    token.clear();
-                    istream.putback(ch);
-                    state = START;
+                    m_Token.clear();
+                    m_pStream->putback(ch);
+                    m_State = START;
                 }
                 break;
 #endif
             case RUN_TO_ENDLINE:
                 if (ch == '\n')
                 {
-                    line++;
-                    state = START;
+                    m_Line++;
+                    m_Spaced = true;
+                    m_State = START;
                 }
                 break;
         }
+
+        ///A token's terminator is always put back, so no whitespace was read
+        ///since the token began
+        if (result)
+        {
+            result->setLeadingSpace(m_Spaced);
+            m_Spaced = false;
+            return result;
+        }
     }
-    ///If we're not in START at EOF, we have a token that failed to be recognized
-    if (state != START)
-        switch (state)
+
+    ///If we're not in START at EOF, the token being read is dropped
+    m_pStream = 0;
+    return 0;
+}
+
+/*!
+ * \brief Skips the rest of a conditional region whose condition is false.
+ * \param depth The number of conditionals already opened within the region.
+ * \return true if the #endif closing the region was found; otherwise false,
+ *         and the stream is exhausted.
+ *
+ * No tokens are made. Whole lines are skipped as raw characters, and only the
+ * first word of a line beginning with '#' is read, to track the nesting of
+ * #ifdef and #ifndef. The rest of the current line is skipped too, so the
+ * region begins on the line after its directive. After the closing #endif,
+ * tokenizing resumes as though the #endif had been returned as a token.
+ */
+bool Lex::skipConditional(int depth)
+{
+    m_State = START;
+    m_Spaced = true;
+    m_Token.clear();
+    m_Error.clear();
+
+    while (m_pStream &&
+           m_pStream->ignore(std::numeric_limits<std::streamsize>::max(), '\n'))
+    {
+        if (m_pStream->eof())
+            break;
+        m_Line++;
+
+        // Directives may be indented
+        int ch = m_pStream->peek();
+        while (ch == ' ' || ch == '\t' || ch == '\r' || ch == '\f' || ch == '\v')
         {
-            default:
-                //ret = 1;
-                break;
+            m_pStream->get();
+            ch = m_pStream->peek();
         }
+        if (ch != '#')
+            continue;
 
-    return tokens;
+        std::string directive(1, (char)m_pStream->get());
+        while (isalpha(m_pStream->peek()))
+            directive.push_back((char)m_pStream->get());
+
+        if (directive == "#ifdef" || directive == "#ifndef")
+            depth++;
+        else if (directive == "#endif" && depth-- == 0)
+            return true;
+    }
+
+    m_pStream = 0;
+    return false;
 }
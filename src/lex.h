@@ -11,6 +11,7 @@
 #define LEX_H
 
 #include <iostream>
+#include <string>
 
 #define MAX_ID_LENGTH   32 ///Identifier length restriction
 #define OUTPUT_WIDTH    12 ///Formats output, pads lexemes to 12 chars
@@ -44,8 +45,8 @@ enum LEX_STATE {START = 0,
                 RUN_TO_ENDLINE};
 
 /// Forward declarations
+class Token;
 class TokenList;
-class SymbolTable;
 
 /*!
  * \brief The Lex class tokenizes an input file according to the LLC language.
@@ -54,7 +55,7 @@ class Lex
 {
 public:
     /// Constructs a new Lex object.
-    Lex(const SymbolTable &symbolTable);
+    Lex();
 
     /// Tokenizes an input stream.
     TokenList *Analyze(std::istream &istream, const char *filename=0);
@@ -65,9 +66,34 @@ public:
     /// Tokenizes a file.
     TokenList *tokenizeFile(const char *filename);
 
+    /// Starts tokenizing an input stream, one token per call to nextToken().
+    void begin(std::istream &istream, const char *filename=0);
+
+    /// Returns the next token of the stream, or NULL at its end.
+    Token *nextToken();
+
+    /// Skips the stream through the #endif closing an inactive region.
+    bool skipConditional(int depth = 0);
+
 private:
-    /// Reference to a constant SymbolTable object.
-    const SymbolTable &m_SymbolTable;
+    /// The stream being tokenized, or NULL once it is exhausted.
+    std::istream *m_pStream;
+
+    /// Name of the file being tokenized, for error messages.
+    const char *m_pFilename;
+
+    /// State of the lexical analyzer between characters.
+    LEX_STATE m_State;
+
+    /// The current line of the stream.
+    int m_Line;
+
+    /// Whether whitespace or a comment was read since the last token.
+    bool m_Spaced;
+
+    /// The token being read, and any error found in it.
+    std::string m_Token;
+    std::string m_Error;
 };
 
 #endif//LEX_H
@@ -0,0 +1,520 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        macroexpander.cpp
+ *
+ * \brief       Defines the methods of the MacroExpander class.
+ */
+#include "macroexpander.h"
+#include "symboltable.h"
+#include "token.h"
+#include "tokenlist.h"
+#include <stdio.h>
+#include <algorithm>
+
+/// Separate the parts of a memoized expansion's key. Lexemes and token types
+/// are printable, so they never contain these.
+#define KEY_TOKEN_SEPARATOR     '\x1f'
+#define KEY_ARGUMENT_SEPARATOR  '\x1e'
+#define KEY_MACRO_SEPARATOR     '\x1d'
+#define KEY_TYPE_SEPARATOR      '\x1c'
+
+/*!
+ * \brief   Instantiates an expander with no macros.
+ * \param   symbolTable The table the macros of at most one token are found in.
+ */
+MacroExpander::MacroExpander(SymbolTable &symbolTable)
+    :m_SymbolTable(symbolTable), m_MemoHits(0)
+{
+}
+
+/*!
+ * \brief   Destroys the expander. Expansions handed out keep the tokens they
+ *          share.
+ */
+MacroExpander::~MacroExpander()
+{
+    invalidate();
+    for (MacroMap::iterator it = m_Macros.begin(); it != m_Macros.end(); ++it)
+        it->second.m_pBody->release();
+}
+
+/*!
+ * \brief   Defines a macro, replacing any macro by that name.
+ * \param   name        The name of the macro.
+ * \param   parameters  The names of the parameters of a function-like macro,
+ *                      or NULL for an object-like macro.
+ * \param   body        The tokens the macro is replaced by. They are taken,
+ *                      leaving the list empty.
+ */
+void MacroExpander::define(const std::string &name,
+                           const std::vector<std::string> *parameters,
+                           TokenList &body)
+{
+    undefine(name);
+
+    Macro macro;
+    macro.m_FunctionLike = parameters != 0;
+    macro.m_ParameterCount = parameters ? (int)parameters->size() : 0;
+    macro.m_pBody = new TokenBuffer(body);
+
+    // Find the parameters in the body once, rather than on every expansion
+    for (int i = 0; i < macro.m_pBody->length(); i++)
+    {
+        int parameter = -1;
+        Token *token = macro.m_pBody->token(i);
+        if (parameters && token->type() == "ID")
+        {
+            std::vector<std::string>::const_iterator found =
+                std::find(parameters->begin(), parameters->end(), token->lexeme());
+            if (found != parameters->end())
+                parameter = (int)(found - parameters->begin());
+        }
+        macro.m_Parameters.push_back(parameter);
+    }
+
+    m_Macros[name] = macro;
+}
+
+/*!
+ * \brief   Undefines a macro. The memoized expansions which looked its name up
+ *          are forgotten, even if the macro was not defined here, since it may
+ *          have been a macro of the symbol table.
+ * \param   name    The name of the macro.
+ */
+void MacroExpander::undefine(const std::string &name)
+{
+    MacroMap::iterator macro = m_Macros.find(name);
+    if (macro != m_Macros.end())
+    {
+        macro->second.m_pBody->release();
+        m_Macros.erase(macro);
+    }
+    invalidate(name);
+}
+
+/*!
+ * \brief   Forgets every memoized expansion, as must be done whenever macros
+ *          of the symbol table change unseen by the expander.
+ */
+void MacroExpander::invalidate()
+{
+    m_Expansions.clear();
+    m_Dependents.clear();
+
+    for (std::unordered_map<std::string, TokenBuffer*>::iterator it =
+             m_Replacements.begin(); it != m_Replacements.end(); ++it)
+        it->second->release();
+    m_Replacements.clear();
+}
+
+/*!
+ * \brief   Forgets the memoized expansions which looked up a name, as must be
+ *          done whenever a macro by that name is defined or undefined.
+ * \param   name    The name of the macro.
+ *
+ * An expansion which looked the name up found the macro, or found there was
+ * none, either of which may no longer hold. Other expansions are kept.
+ */
+void MacroExpander::invalidate(const std::string &name)
+{
+    std::unordered_map<std::string, std::unordered_set<std::string> >::iterator
+        dependents = m_Dependents.find(name);
+    if (dependents != m_Dependents.end())
+    {
+        std::unordered_set<std::string> keys;
+        keys.swap(dependents->second);
+        m_Dependents.erase(dependents);
+        for (std::unordered_set<std::string>::iterator it = keys.begin();
+             it != keys.end(); ++it)
+            forget(*it);
+    }
+
+    std::unordered_map<std::string, TokenBuffer*>::iterator replacement =
+        m_Replacements.find(name);
+    if (replacement != m_Replacements.end())
+    {
+        replacement->second->release();
+        m_Replacements.erase(replacement);
+    }
+}
+
+/// Returns whether a macro named \p name is defined.
+bool MacroExpander::isDefined(const std::string &name) const
+{
+    return m_Macros.find(name) != m_Macros.end();
+}
+
+/// Returns whether the macro named \p name takes arguments.
+bool MacroExpander::isFunctionLike(const std::string &name) const
+{
+    MacroMap::const_iterator macro = m_Macros.find(name);
+    return macro != m_Macros.end() && macro->second.m_FunctionLike;
+}
+
+/*!
+ * \brief   Expands an invocation of a macro.
+ * \param   name        The name of the macro, held here or in the symbol table.
+ * \param   arguments   The raw tokens of each argument, empty for an
+ *                      object-like macro.
+ * \param   expansion   The sequence to append the expansion to.
+ * \return  true if the macro was expanded; false if it is not defined or was
+ *          given the wrong number of arguments.
+ */
+bool MacroExpander::expand(const std::string &name,
+                           std::vector<TokenSequence> &arguments,
+                           TokenSequence &expansion)
+{
+    std::vector<std::string> hidden;
+    m_LookedUp.clear();
+    MacroMap::iterator macro = m_Macros.find(name);
+    if (macro == m_Macros.end())
+        return expandSymbol(name, hidden, expansion);
+
+    return expandMacro(name, macro->second, arguments, hidden, expansion);
+}
+
+/*!
+ * \brief   Finds the function-like macro whose name ends an expansion, which
+ *          may take its arguments from the tokens after the invocation.
+ * \param   expansion   The expansion.
+ * \param   macro       The name of the macro \p expansion is the expansion of.
+ * \param   last        Left at the macro's name, if there is one.
+ * \return  The name of the macro, or an empty string if the expansion does not
+ *          end in the name of a function-like macro other than \p macro.
+ *
+ * A macro's name left by its own expansion was hidden when the expansion was
+ * rescanned, and stays so: it is not invoked, whatever follows it.
+ */
+std::string MacroExpander::trailingInvocation(TokenSequence &expansion,
+                                              const std::string &macro,
+                                              TokenSequence::iterator &last) const
+{
+    if (!expansion.length())
+        return std::string();
+
+    last = expansion.end();
+    --last;
+    if ((*last)->type() != "ID" || (*last)->lexeme() == macro ||
+        !isFunctionLike((*last)->lexeme()))
+        return std::string();
+    return (*last)->lexeme();
+}
+
+/// Returns the number of expansions found memoized.
+unsigned long MacroExpander::memoHits() const
+{
+    return m_MemoHits;
+}
+
+/*!
+ * \brief   Splits the arguments of an invocation.
+ * \param   pos         The token following the macro's name. Left after the
+ *                      closing ')' if the arguments are complete.
+ * \param   end         The end of the tokens the arguments may be taken from.
+ * \param   arguments   Receives the tokens of each argument, which may be
+ *                      empty.
+ * \return  true if \p pos is at a '(' closed before \p end; otherwise false,
+ *          and the macro is not invoked.
+ *
+ * Arguments are separated by the commas not within nested parentheses.
+ */
+bool MacroExpander::collectArguments(TokenSequence::iterator &pos,
+                                     TokenSequence::iterator end,
+                                     std::vector<TokenSequence> &arguments)
+{
+    if (pos == end || (*pos)->type() != "(")
+        return false;
+
+    arguments.clear();
+    arguments.push_back(TokenSequence());
+    TokenSequence::iterator start = ++pos;
+
+    for (int depth = 0; pos != end; ++pos)
+    {
+        std::string type = (*pos)->type();
+        if (type == "(")
+        {
+            depth++;
+        }
+        else if (type == ")" && depth)
+        {
+            depth--;
+        }
+        else if (type == ")" || (type == "," && !depth))
+        {
+            arguments.back().append(start, pos);
+            start = pos;
+            ++start;
+            if (type == ")")
+            {
+                pos = start;
+                return true;
+            }
+            arguments.push_back(TokenSequence());
+        }
+    }
+    return false;
+}
+
+/*!
+ * \brief   Expands an invocation of a macro, or finds it memoized.
+ * \param   name        The name of the macro.
+ * \param   macro       The macro.
+ * \param   arguments   The raw tokens of each argument.
+ * \param   hidden      The macros being expanded around the invocation, which
+ *                      are not expanded again within it.
+ * \param   expansion   The sequence to append the expansion to.
+ * \return  true if the macro was expanded; false if it was given the wrong
+ *          number of arguments.
+ */
+bool MacroExpander::expandMacro(const std::string &name, const Macro &macro,
+                                std::vector<TokenSequence> &arguments,
+                                std::vector<std::string> &hidden,
+                                TokenSequence &expansion)
+{
+    // A macro without parameters is invoked with one empty argument
+    size_t count = arguments.size();
+    if (macro.m_FunctionLike && !macro.m_ParameterCount && count == 1 &&
+        !arguments[0].length())
+        count = 0;
+
+    if ((int)count != macro.m_ParameterCount)
+    {
+        printf("macro %s requires %d arguments, but %d given\n", name.c_str(),
+               macro.m_ParameterCount, (int)count);
+        return false;
+    }
+
+    std::string key;
+    for (size_t i = 0; i < hidden.size(); i++)
+        key += hidden[i] + KEY_MACRO_SEPARATOR;
+    key += name;
+    for (size_t i = 0; i < count; i++)
+    {
+        key += KEY_ARGUMENT_SEPARATOR;
+        for (TokenSequence::iterator it = arguments[i].begin();
+             it != arguments[i].end(); ++it)
+            key += (*it)->lexeme() + KEY_TYPE_SEPARATOR + (*it)->type() +
+                   KEY_TOKEN_SEPARATOR;
+    }
+
+    // An expansion found memoized looked up the same names as it did then
+    std::unordered_map<std::string, Memo>::iterator memoized =
+        m_Expansions.find(key);
+    if (memoized != m_Expansions.end())
+    {
+        m_MemoHits++;
+        m_LookedUp.insert(m_LookedUp.end(),
+                          memoized->second.m_Dependencies.begin(),
+                          memoized->second.m_Dependencies.end());
+        expansion.insert(expansion.end(), memoized->second.m_Expansion);
+        return true;
+    }
+    size_t lookedUp = m_LookedUp.size();
+    m_LookedUp.push_back(name);
+
+    // Arguments are expanded before they are substituted
+    std::vector<TokenSequence> expanded(count);
+    for (size_t i = 0; i < count; i++)
+        rescan(arguments[i], hidden, expanded[i]);
+
+    // Substitute them for the parameters, sharing the runs of body between
+    TokenSequence body, substituted;
+    body.append(macro.m_pBody);
+    TokenSequence::iterator run = body.begin(), it = body.begin();
+    for (int i = 0; i < macro.m_pBody->length(); i++, ++it)
+    {
+        int parameter = macro.m_Parameters[i];
+        if (parameter < 0)
+            continue;
+
+        substituted.append(run, it);
+        substituted.insert(substituted.end(), expanded[parameter]);
+        run = it;
+        ++run;
+    }
+    substituted.append(run, body.end());
+
+    // Rescan with the macro hidden, so that it cannot expand itself
+    TokenSequence result;
+    hidden.push_back(name);
+    rescan(substituted, hidden, result);
+    hidden.pop_back();
+
+    // Note each name looked up, so that defining it forgets the expansion
+    Memo &memo = m_Expansions[key];
+    memo.m_Expansion = result;
+    for (size_t i = lookedUp; i < m_LookedUp.size(); i++)
+        if (m_Dependents[m_LookedUp[i]].insert(key).second)
+            memo.m_Dependencies.push_back(m_LookedUp[i]);
+
+    expansion.insert(expansion.end(), result);
+    return true;
+}
+
+/*!
+ * \brief   Forgets a memoized expansion, and that it looked up its names.
+ * \param   key     The expansion's key.
+ */
+void MacroExpander::forget(const std::string &key)
+{
+    std::unordered_map<std::string, Memo>::iterator memo = m_Expansions.find(key);
+    if (memo == m_Expansions.end())
+        return;
+
+    const std::vector<std::string> &dependencies = memo->second.m_Dependencies;
+    for (size_t i = 0; i < dependencies.size(); i++)
+    {
+        std::unordered_map<std::string, std::unordered_set<std::string> >::iterator
+            dependents = m_Dependents.find(dependencies[i]);
+        if (dependents == m_Dependents.end())
+            continue;
+        dependents->second.erase(key);
+        if (dependents->second.empty())
+            m_Dependents.erase(dependents);
+    }
+    m_Expansions.erase(memo);
+}
+
+/*!
+ * \brief   Expands a macro of the symbol table.
+ * \param   name        The name of the macro.
+ * \param   hidden      The macros being expanded around the macro.
+ * \param   expansion   The sequence to append the expansion to.
+ * \return  true if \p name is a symbol, otherwise false.
+ */
+bool MacroExpander::expandSymbol(const std::string &name,
+                                 std::vector<std::string> &hidden,
+                                 TokenSequence &expansion)
+{
+    // A symbol without a value is replaced by nothing
+    SymbolPtr symbol = m_SymbolTable.findSymbol(name.c_str());
+    if (symbol.isNull())
+        return false;
+    if (!symbol.constData())
+        return true;
+
+    TokenSequence value;
+    value.append(replacement(name, symbol.constData(), symbol.use() == EU_ID));
+    if (symbol.use() != EU_ID)
+    {
+        expansion.insert(expansion.end(), value);
+        return true;
+    }
+
+    // An identifier may name another macro, which must not lead back to this one
+    hidden.push_back(name);
+    rescan(value, hidden, expansion);
+    hidden.pop_back();
+    return true;
+}
+
+/*!
+ * \brief   Expands every macro in a sequence of tokens.
+ * \param   input   The tokens to expand.
+ * \param   hidden  The macros being expanded around the tokens, which are
+ *                  left as they are.
+ * \param   output  The sequence to append the expanded tokens to. Runs of
+ *                  \p input without macros are shared, not copied.
+ */
+void MacroExpander::rescan(TokenSequence &input, std::vector<std::string> &hidden,
+                           TokenSequence &output)
+{
+    TokenSequence::iterator run = input.begin(), it = input.begin();
+    while (it != input.end())
+    {
+        Token *token = *it;
+        TokenSequence::iterator next = it;
+        ++next;
+
+        std::string name;
+        if (token->type() == "ID")
+            name = token->lexeme();
+        if (name.empty() ||
+            std::find(hidden.begin(), hidden.end(), name) != hidden.end())
+        {
+            it = next;
+            continue;
+        }
+
+        TokenSequence expansion;
+        m_LookedUp.push_back(name);
+        MacroMap::iterator macro = m_Macros.find(name);
+        if (macro == m_Macros.end())
+        {
+            if (!expandSymbol(name, hidden, expansion))
+            {
+                it = next;
+                continue;
+            }
+        }
+        else
+        {
+            // A function-like macro is only invoked when followed by arguments
+            std::vector<TokenSequence> arguments;
+            if (macro->second.m_FunctionLike &&
+                !collectArguments(next, input.end(), arguments))
+            {
+                it = next;
+                continue;
+            }
+
+            if (!expandMacro(name, macro->second, arguments, hidden, expansion))
+                expansion.append(it, next);
+        }
+
+        // A function-like macro ending the expansion takes its arguments from
+        // the tokens after the invocation
+        TokenSequence::iterator last;
+        std::string trailing;
+        while (!(trailing = trailingInvocation(expansion, name, last)).empty() &&
+               std::find(hidden.begin(), hidden.end(), trailing) == hidden.end())
+        {
+            name = trailing;
+            std::vector<TokenSequence> arguments;
+            TokenSequence::iterator after = next;
+            if (!collectArguments(after, input.end(), arguments))
+                break;
+
+            TokenSequence chained;
+            chained.append(expansion.begin(), last);
+            if (!expandMacro(name, m_Macros[name], arguments, hidden, chained))
+            {
+                chained.append(last, expansion.end());
+                chained.append(next, after);
+            }
+            expansion = chained;
+            next = after;
+        }
+
+        output.append(run, it);
+        output.insert(output.end(), expansion);
+        run = it = next;
+    }
+    output.append(run, input.end());
+}
+
+/*!
+ * \brief   Gets the token a macro of the symbol table is replaced by.
+ * \param   name    The name of the macro.
+ * \param   value   The macro's value.
+ * \param   id      Whether the value is an identifier, rather than a constant.
+ * \return  A buffer of the one token, kept until the macro is invalidated.
+ */
+TokenBuffer *MacroExpander::replacement(const std::string &name,
+                                        const char *value, bool id)
+{
+    std::unordered_map<std::string, TokenBuffer*>::iterator found =
+        m_Replacements.find(name);
+    if (found != m_Replacements.end())
+        return found->second;
+
+    TokenList tokens;
+    tokens.add(new Token(value, id ? "ID" : "CONSTANT"));
+    TokenBuffer *buffer = new TokenBuffer(tokens);
+    m_Replacements[name] = buffer;
+    return buffer;
+}
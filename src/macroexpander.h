@@ -0,0 +1,177 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        macroexpander.h
+ *
+ * \brief       Declares the structure of the MacroExpander class.
+ */
+#ifndef MACROEXPANDER_H
+#define MACROEXPANDER_H
+
+#include "tokensequence.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class SymbolTable;
+class Token;
+class TokenList;
+
+/*!
+ * \brief   The MacroExpander class holds the macros whose replacement is more
+ *          than one token, including function-like macros, and expands their
+ *          invocations. It is an implementation detail of Preprocessor.
+ *
+ * An invocation's arguments are expanded first, then substituted for the
+ * parameters in the body, and the result is rescanned for more macros. A
+ * macro is hidden while its own expansion is rescanned, so a macro which
+ * names itself, directly or through others, is left as it is rather than
+ * expanded without end. The expansion is rescanned alone, not together with
+ * the tokens following the invocation.
+ *
+ * Expansions are token sequences: runs of the body and of the arguments are
+ * shared, never copied. Each expansion is memoized by the macro, the lexemes
+ * and types of its arguments' tokens and the macros hidden around it, so a
+ * repeated invocation costs one lookup. A memoized expansion notes every name
+ * looked up while it was made, macro or not, and defining or undefining a
+ * macro forgets only the expansions which looked its name up.
+ *
+ * Macros of at most one token live in the symbol table alone, and are
+ * expanded here too. A value which is an identifier is rescanned with the
+ * macro hidden, so it may name another macro.
+ *
+ * A function-like macro whose name ends an expansion takes its arguments from
+ * the tokens after the invocation, as though it had been written there. Its
+ * name stays hidden if it was left by its own expansion, so that with
+ * f(x) defined as f, f(1)(2) expands to f(2) and no further.
+ */
+class MacroExpander
+{
+public:
+    /// Creates an expander with no macros, which finds other macros in
+    /// \p symbolTable.
+    MacroExpander(SymbolTable &symbolTable);
+
+    /// Releases the macros' bodies and the memoized expansions.
+    ~MacroExpander();
+
+    /// Defines an object-like macro, or a function-like one if \p parameters
+    /// is not NULL, whose body is \p body.
+    void define(const std::string &name,
+                const std::vector<std::string> *parameters, TokenList &body);
+
+    /// Undefines a macro, if it is defined.
+    void undefine(const std::string &name);
+
+    /// Forgets every memoized expansion.
+    void invalidate();
+
+    /// Forgets the memoized expansions which looked up the name \p name.
+    void invalidate(const std::string &name);
+
+    /// Returns whether a macro named \p name is defined.
+    bool isDefined(const std::string &name) const;
+
+    /// Returns whether the macro named \p name takes arguments.
+    bool isFunctionLike(const std::string &name) const;
+
+    /// Expands an invocation of the macro named \p name, held here or in the
+    /// symbol table.
+    bool expand(const std::string &name, std::vector<TokenSequence> &arguments,
+                TokenSequence &expansion);
+
+    /// Finds the function-like macro whose name ends \p expansion, the
+    /// expansion of the macro named \p macro.
+    std::string trailingInvocation(TokenSequence &expansion,
+                                   const std::string &macro,
+                                   TokenSequence::iterator &last) const;
+
+    /// Returns the number of expansions found memoized.
+    unsigned long memoHits() const;
+
+    /// Splits the arguments of an invocation, which open at \p pos.
+    static bool collectArguments(TokenSequence::iterator &pos,
+                                 TokenSequence::iterator end,
+                                 std::vector<TokenSequence> &arguments);
+
+private:
+    /// A macro's definition.
+    struct Macro
+    {
+        /// Whether the macro takes arguments.
+        bool m_FunctionLike;
+
+        /// The number of parameters.
+        int m_ParameterCount;
+
+        /// The body's tokens.
+        TokenBuffer *m_pBody;
+
+        /// For each token of the body, the parameter it names, or -1.
+        std::vector<int> m_Parameters;
+    };
+
+    typedef std::unordered_map<std::string, Macro> MacroMap;
+
+    /// A memoized expansion.
+    struct Memo
+    {
+        /// The expansion's tokens.
+        TokenSequence m_Expansion;
+
+        /// The names looked up while the expansion was made.
+        std::vector<std::string> m_Dependencies;
+    };
+
+    // Expanders own their macros and are not copyable
+    MacroExpander(const MacroExpander&);
+    MacroExpander& operator=(const MacroExpander&);
+
+    /// Expands an invocation, with \p hidden hidden around it.
+    bool expandMacro(const std::string &name, const Macro &macro,
+                     std::vector<TokenSequence> &arguments,
+                     std::vector<std::string> &hidden, TokenSequence &expansion);
+
+    /// Expands a macro of the symbol table, with \p hidden hidden around it.
+    bool expandSymbol(const std::string &name, std::vector<std::string> &hidden,
+                      TokenSequence &expansion);
+
+    /// Appends \p input to \p output with every macro in it expanded.
+    void rescan(TokenSequence &input, std::vector<std::string> &hidden,
+                TokenSequence &output);
+
+    /// Forgets the memoized expansion whose key is \p key.
+    void forget(const std::string &key);
+
+    /// Gets a buffer of the one token a symbol table macro is replaced by.
+    TokenBuffer *replacement(const std::string &name, const char *value,
+                             bool id);
+
+    /// The macros, by name.
+    MacroMap m_Macros;
+
+    /// The memoized expansions, by macro, arguments and hidden macros.
+    std::unordered_map<std::string, Memo> m_Expansions;
+
+    /// The keys of the memoized expansions which looked up each name.
+    std::unordered_map<std::string,
+                       std::unordered_set<std::string> > m_Dependents;
+
+    /// The names looked up by the expansion under way, in order, of which
+    /// each memoized expansion keeps those looked up since it began.
+    std::vector<std::string> m_LookedUp;
+
+    /// The tokens of the symbol table macros met so far, by name.
+    std::unordered_map<std::string, TokenBuffer*> m_Replacements;
+
+    /// The table the other macros are found in.
+    SymbolTable &m_SymbolTable;
+
+    /// The number of expansions found memoized.
+    unsigned long m_MemoHits;
+};
+
+#endif//MACROEXPANDER_H
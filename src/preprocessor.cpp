@@ -8,194 +8,704 @@
  * \brief       Defines the structure of the Preprocessor class.
  */
 #include "preprocessor.h"
+#include "includecache.h"
 #include "symboltable.h"
 #include "token.h"
 #include "tokenlist.h"
 #include <stdio.h>
 #include <string.h>
+#include <fstream>
 #include "lex.h"
 
+/// The most identifiers whose symbols are looked up as one batch.
+#define MACRO_LOOKUP_WINDOW     16
+
+/// The most tokens held back while a window of identifiers is gathered.
+#define MACRO_LOOKUP_TOKENS     (MACRO_LOOKUP_WINDOW * 4)
+
 /*!
  * \brief Creates a preprocessor object, maintaining reference to \p symbolTable.
  * \param symbolTable   A reference to an instantiated symbol table.
+ * \param includeCache  The cache to read included files from, which must
+ *                      outlive the preprocessor, or NULL for a cache of its own.
+ */
+Preprocessor::Preprocessor(SymbolTable &symbolTable, IncludeCache *includeCache)
+    :m_SymbolTable(symbolTable), m_pIncludeCache(includeCache),
+     m_OwnsIncludeCache(!includeCache), m_Expander(symbolTable)
+{
+    if (m_OwnsIncludeCache)
+        m_pIncludeCache = new IncludeCache;
+}
+
+/*!
+ * \brief Destroys a preprocessor, closing any sources still open and deleting
+ *        the tokens read from them. A list source deletes its own tokens.
+ */
+Preprocessor::~Preprocessor()
+{
+    // Sources cut short leave their conditionals open, which is no error
+    m_Conditionals.clear();
+    while (!m_Sources.empty())
+    {
+        delete takeToken();
+        closeSource();
+    }
+
+    for (size_t i = 0; i < m_Output.size(); i++)
+        delete m_Output[i];
+
+    if (m_OwnsIncludeCache)
+        delete m_pIncludeCache;
+}
+
+/*!
+ * \brief Starts preprocessing a file. Its tokens come before the rest of any
+ *        file opened before and not yet exhausted.
+ * \param filename  The path of the file.
+ * \return true if the file was opened, otherwise false.
  */
-Preprocessor::Preprocessor(SymbolTable &symbolTable)
-    :m_SymbolTable(symbolTable), m_IfPreproc(false)
+bool Preprocessor::openFile(const char *filename)
 {
+    return filename && pushFile(filename);
+}
+
+/*!
+ * \brief Preprocesses raw tokens until one is final.
+ * \return The next token of the preprocessed input, which the caller owns, or
+ *         NULL once every source is exhausted.
+ *
+ * Directives are acted on as they are read, and consume the tokens they apply
+ * to. An #include pushes the included file, whose tokens come next. Only
+ * identifiers, a window at a time, are held back to look up macros.
+ */
+Token *Preprocessor::nextToken()
+{
+    while (m_Output.empty())
+    {
+        if (m_Sources.empty())
+            return 0;
+
+        Token *token = peekToken();
+        if (!token)
+        {
+            closeSource();
+        }
+        else if (token->type() == "PREPROCESSOR")
+        {
+            // Take the directive off the source and act on it
+            takeToken();
+            processDirective(token);
+            delete token;
+        }
+        else if (token->type() == "ID")
+        {
+            // Replace defined macros
+            replaceMacros();
+        }
+        else
+        {
+            m_Output.push_back(takeToken());
+        }
+    }
+
+    Token *token = m_Output.front();
+    m_Output.pop_front();
+    return token;
 }
 
 /*!
  * \brief Processes preprocessor directives in the given token list.
  * \param tokens    A list of tokens which will be modified according to the
  *                  preprocessor directives it contains.
+ *
+ * The list is drained through the same engine as a file, and refilled with
+ * the tokens it yields. A file opened before is left where it was.
  */
 void Preprocessor::process(TokenList &tokens)
 {
-    // int implies a unit of program maximum length of 2 billion tokens
-    for (int i = 0; i < tokens.length(); i++)
+    std::vector<Source*> sources;
+    std::deque<Token*> output;
+    std::vector<Conditional> conditionals;
+    sources.swap(m_Sources);
+    output.swap(m_Output);
+    conditionals.swap(m_Conditionals);
+
+    Source *source = new Source();
+    source->m_pTokens = new TokenList;
+    source->m_pTokens->splice(0, tokens);
+    m_Sources.push_back(source);
+
+    while (Token *token = nextToken())
+        tokens.add(token);
+
+    m_Sources.swap(sources);
+    m_Output.swap(output);
+    m_Conditionals.swap(conditionals);
+}
+
+/*!
+ * \brief Pushes a file onto the stack of sources.
+ * \param filename  The path of the file.
+ * \return true if the file was opened, otherwise false.
+ */
+bool Preprocessor::pushFile(const std::string &filename)
+{
+    std::ifstream *stream = new std::ifstream(filename.c_str());
+    if (!*stream)
     {
-        if (tokens[i]->type() != "PREPROCESSOR")
+        delete stream;
+        return false;
+    }
+
+    Source *source = new Source();
+    source->m_pStream = stream;
+    source->m_Filename = filename;
+    source->m_pLex = new Lex();
+    source->m_pLex->begin(*stream, source->m_Filename.c_str());
+
+    // Note the file, so that it can neither include itself nor, once it asks
+    // for #pragma once, be included at all
+    FileInfo file;
+    if (IncludeCache::statFile(filename.c_str(), file))
+    {
+        IncludeStack.push_back(file.m_Id);
+        source->m_File = file.m_Id;
+        source->m_OnIncludeStack = true;
+    }
+
+    m_Sources.push_back(source);
+    return true;
+}
+
+/*!
+ * \brief Pushes an included file onto the stack of sources. Its tokens are
+ *        copied from the include cache, which lexes the file only the first
+ *        time it is included or after it changes.
+ * \param filename  The path of the file.
+ * \return true if the file was found, otherwise false.
+ *
+ * The file is identified by device and inode with a single stat, before it is
+ * opened, so that however it is reached, a file marked #pragma once is not
+ * read again and a file being read is not included into itself. A file
+ * wrapped in an include guard which is already defined is not pushed either,
+ * as each of its tokens would be removed along with the guard's #ifndef.
+ */
+bool Preprocessor::pushInclude(const std::string &filename)
+{
+    FileInfo file;
+    if (!IncludeCache::statFile(filename.c_str(), file))
+        return false;
+
+    if (m_OnceFiles.count(file.m_Id))
+        return true;
+
+    for (size_t j = 0; j < IncludeStack.size(); j++)
+        if (IncludeStack[j] == file.m_Id)
         {
-            if (tokens[i]->type() != "ID")
-                continue;
+            printf("prevented duplicate include of %s\n", filename.c_str());
+            return false;
+        }
 
-            // Replace defined macros
-            SymbolPtr symbol = m_SymbolTable.findSymbol(tokens[i]->lexeme().c_str());
-            if (!symbol.isNull())
-            {
-                Token *before = tokens[i];
-                Token *replacement = new Token(symbol.constData(),
-                                         symbol.use() == EU_ID ? "ID" : "CONSTANT");
-                tokens.insertBefore(replacement, before);
-                tokens.remove(before);
-                delete before;
-            }
-            continue;
+    std::string guard;
+    TokenBuffer *buffer = m_pIncludeCache->tokens(file, &guard);
+
+    // A file whose include guard is defined would yield nothing; skip it
+    if (!guard.empty() && !m_SymbolTable.findSymbol(guard.c_str()).isNull())
+    {
+        buffer->release();
+        return true;
+    }
+
+    // The included file's tokens come next; closing it pops the stack
+    IncludeStack.push_back(file.m_Id);
+
+    Source *source = new Source();
+    source->m_Filename = filename;
+    source->m_pBuffer = buffer;
+    source->m_File = file.m_Id;
+    source->m_OnIncludeStack = true;
+    m_Sources.push_back(source);
+    return true;
+}
+
+/*!
+ * \brief Pops and frees the innermost source, whose tokens are all taken.
+ */
+void Preprocessor::closeSource()
+{
+    // A region cannot continue past the end of its file
+    while (!m_Conditionals.empty() &&
+           m_Conditionals.back().m_SourceDepth == m_Sources.size())
+    {
+        printf("unterminated %s\n", m_Conditionals.back().m_Directive.c_str());
+        m_Conditionals.pop_back();
+    }
+
+    Source *source = m_Sources.back();
+    m_Sources.pop_back();
+
+    if (source->m_OnIncludeStack && !IncludeStack.empty())
+        IncludeStack.pop_back();
+
+    delete source->m_pLex;
+    delete source->m_pStream;
+    delete source->m_pTokens;
+    if (source->m_pBuffer)
+        source->m_pBuffer->release();
+    delete source;
+}
+
+/*!
+ * \brief Reads ahead one raw token of the innermost source.
+ * \return The next raw token, still owned by the source, or NULL when the
+ *         source is exhausted. Tokens of outer sources are never returned, so a
+ *         directive cannot reach past the end of its file.
+ */
+Token *Preprocessor::peekToken()
+{
+    Source *source = m_Sources.back();
+    if (!source->m_pPeekedToken)
+    {
+        if (source->m_pLex)
+        {
+            source->m_pPeekedToken = source->m_pLex->nextToken();
         }
+        else if (source->m_pBuffer)
+        {
+            // The buffer keeps its tokens for the next includer
+            if (source->m_BufferIndex < source->m_pBuffer->length())
+                source->m_pPeekedToken = new Token(
+                    *source->m_pBuffer->token(source->m_BufferIndex++));
+        }
+        else
+        {
+            TokenCursor cursor(*source->m_pTokens);
+            if (!cursor.atEnd())
+                source->m_pPeekedToken = cursor.erase();
+        }
+    }
+    return source->m_pPeekedToken;
+}
 
-        // Maintain pointer to token and remove proprocessor token from list
-        Token *token = tokens[i];
-        tokens.remove(token);
+/*!
+ * \brief Takes the next raw token of the innermost source.
+ * \return The token, which the caller owns, or NULL when the source is
+ *         exhausted.
+ */
+Token *Preprocessor::takeToken()
+{
+    Token *token = peekToken();
+    m_Sources.back()->m_pPeekedToken = 0;
+    return token;
+}
 
-        if (token->lexeme() == "#define")
+/*!
+ * \brief Acts on a preprocessor directive.
+ * \param token The directive, already taken from its source.
+ */
+void Preprocessor::processDirective(Token *token)
+{
+    if (token->lexeme() == "#define")
+    {
+        // Look an identifier to name the macro
+        if (!peekToken() || peekToken()->type() != "ID")
         {
-            // Look an identifier to name the macro
-            if (tokens[i]->type() != "ID")
-            {
-                printf("no macro name given in #define directive\n");
-                continue;
-            }
-            Token *macro = tokens[i];
-            tokens.remove(macro);
+            printf("no macro name given in #define directive\n");
+            return;
+        }
+        Token *macro = takeToken();
+        std::string name = macro->lexeme();
+        int line = macro->line();
+        delete macro;
 
-            // Look for an identifier or constant to use as the macro's value
-            Token *value = NULL;
-            if (tokens[i]->type() == "ID" || tokens[i]->type() == "CONSTANT")
+        // A '(' right after the name, with no space between, opens the
+        // parameters of a function-like macro. Tokens of an unknown line, not
+        // from a file, give no function-like macros, and at most an identifier
+        // or constant as the value.
+        std::vector<std::string> parameters;
+        bool functionLike = line && peekToken() && peekToken()->type() == "(" &&
+                            peekToken()->line() == line &&
+                            !peekToken()->leadingSpace();
+        if (functionLike && !takeParameters(line, parameters))
+        {
+            printf("invalid parameter list in #define of %s\n", name.c_str());
+            while (peekToken() && peekToken()->line() == line &&
+                   peekToken()->type() != "PREPROCESSOR")
+                delete takeToken();
+            return;
+        }
+
+        // The rest of the line is the macro's body
+        TokenList body;
+        while (peekToken() && peekToken()->type() != "PREPROCESSOR" &&
+               (line ? peekToken()->line() == line :
+                       !body.length() && (peekToken()->type() == "ID" ||
+                                          peekToken()->type() == "CONSTANT")))
+            body.add(takeToken());
+
+        // An identifier or constant alone is kept as the symbol's value
+        E_USE use = EU_MACRO;
+        std::string value;
+        if (!functionLike && body.length() == 1)
+        {
+            Token *only = *body.begin();
+            if (only->type() == "ID" || only->type() == "CONSTANT")
             {
-                value = tokens[i];
-                tokens.remove(value);
+                use = only->type() == "ID" ? EU_ID : EU_CONSTANT;
+                value = only->lexeme();
             }
+        }
 
-            E_USE use = EU_MACRO;
-            if (value) {
-                if (value->type() == "ID")
-                    use = EU_ID;
-                else
-                    use = EU_CONSTANT;
-            }
-            // Add a preprocessor macro symbol, with const value if value exists
-            m_SymbolTable.addSymbol(macro->lexeme().c_str(), ET_VOID, use,
-                                    value ? value->lexeme().c_str() : NULL);
-            delete macro;
-            if (value) delete value;
-            i--;
+        // Add a preprocessor macro symbol, with const value if value exists
+        if (m_SymbolTable.addSymbol(name.c_str(), ET_VOID, use,
+                                    use != EU_MACRO ? value.c_str() : NULL))
+        {
+            if (use == EU_MACRO && (functionLike || body.length()))
+                m_Expander.define(name, functionLike ? &parameters : 0, body);
+            else
+                m_Expander.invalidate(name);
         }
-        else if (token->lexeme() == "#undef")
+
+        for (TokenList::iterator it = body.begin(); it != body.end(); ++it)
+            delete *it;
+    }
+    else if (token->lexeme() == "#undef")
+    {
+        // Look an identifier to name the macro
+        if (!peekToken() || peekToken()->type() != "ID")
         {
-            // Look an identifier to name the macro
-            if (tokens[i]->type() != "ID")
-            {
-                printf("no macro name given in #define directive\n");
-                continue;
-            }
-            Token *macro = tokens[i];
-            tokens.remove(macro);
-            m_SymbolTable.removeSymbol(macro->lexeme().c_str());
-            delete macro;
-            i--;
+            printf("no macro name given in #define directive\n");
+            return;
         }
-        else if (token->lexeme() == "#ifdef" ||
-                 token->lexeme() == "#ifndef")
+        Token *macro = takeToken();
+        m_SymbolTable.removeSymbol(macro->lexeme().c_str());
+        m_Expander.undefine(macro->lexeme());
+        delete macro;
+    }
+    else if (token->lexeme() == "#ifdef" ||
+             token->lexeme() == "#ifndef")
+    {
+        bool nullPasses = token->lexeme() == "#ifndef";
+
+        // Look an identifier to name the macro
+        if (!peekToken() || peekToken()->type() != "ID")
         {
-            bool nullPasses = token->lexeme() == "#ifndef";
+            printf("no macro name given in %s directive\n", token->lexeme().c_str());
+            return;
+        }
+        Token *macro = takeToken();
 
-            // Look an identifier to name the macro
-            if (tokens[i]->type() != "ID")
-            {
-                printf("no macro name given in %s directive\n", token->lexeme().c_str());
-                continue;
-            }
-            Token *macro = tokens[i];
-            tokens.remove(macro);
+        // Look for a defined macro symbol
+        SymbolPtr symbol = m_SymbolTable.findSymbol(macro->lexeme().c_str());
+
+        // Depending on directive value, skip the region or read it
+        if (symbol.isNull() ^ nullPasses) {
+            if (!skipConditional())
+                printf("unterminated %s\n", token->lexeme().c_str());
+        }
+        else
+        {
+            Conditional conditional;
+            conditional.m_Directive = token->lexeme();
+            conditional.m_SourceDepth = m_Sources.size();
+            m_Conditionals.push_back(conditional);
+        }
+        delete macro;
+    }
+    else if (token->lexeme() == "#endif")
+    {
+        if (m_Conditionals.empty() ||
+            m_Conditionals.back().m_SourceDepth != m_Sources.size())
+            printf("#endif without #if\n");
+        else
+            m_Conditionals.pop_back();
+    }
+    else if (token->lexeme() == "#include")
+    {
+        if (!peekToken() || peekToken()->type() != "STRING")
+        {
+            printf("#include expects \"FILENAME\"\n");
+            return;
+        }
 
-            // Look for a defined macro symbol
-            SymbolPtr symbol = m_SymbolTable.findSymbol(macro->lexeme().c_str());
+        // Get include path token
+        Token *path = takeToken();
+        std::string filename = path->lexeme().substr(1, path->lexeme().length() - 2);
+        delete path;
 
-            // Depending on directive value, ignore tokens until #endif
-            if (symbol.isNull() ^ nullPasses) {
-                if (!removeTokensUntilEndif(i, tokens))
-                    printf("unterminated %s\n", token->lexeme().c_str());
-            }
-            else
-                m_IfPreproc = true;
-            delete macro;
+        pushInclude(filename);
+    }
+    else if (token->lexeme() == "#pragma")
+    {
+        // Only #pragma once is known; any other pragma is ignored
+        if (!peekToken() || peekToken()->type() != "ID" ||
+            peekToken()->lexeme() != "once")
+            return;
+        delete takeToken();
+
+        Source *source = m_Sources.back();
+        if (source->m_OnIncludeStack)
+            m_OnceFiles.insert(source->m_File);
+    }
+}
+
+/*!
+ * \brief Replaces macros in a window of identifiers, starting at the next
+ *        raw token, and queues the window for output.
+ *
+ * The window holds up to MACRO_LOOKUP_WINDOW identifiers and ends before the
+ * next directive, which may change what they mean, or the end of the source.
+ * Their symbols are looked up in one batch, so that the lookups' cache misses
+ * overlap. At most MACRO_LOOKUP_TOKENS tokens are held back.
+ */
+void Preprocessor::replaceMacros()
+{
+    Token *window[MACRO_LOOKUP_TOKENS];
+    std::string lexemes[MACRO_LOOKUP_WINDOW];
+    const char *names[MACRO_LOOKUP_WINDOW];
+    int size = 0, count = 0;
+
+    while (size < MACRO_LOOKUP_TOKENS && count < MACRO_LOOKUP_WINDOW)
+    {
+        Token *token = peekToken();
+        if (!token || token->type() == "PREPROCESSOR")
+            break;
+
+        window[size++] = takeToken();
+        if (token->type() != "ID")
+            continue;
+
+        lexemes[count] = token->lexeme();
+        names[count] = lexemes[count].c_str();
+        count++;
+    }
+
+    std::vector<SymbolPtr> symbols;
+    m_SymbolTable.findSymbols(names, count, symbols);
+
+    for (int i = 0, id = 0; i < size; i++)
+    {
+        Token *token = window[i];
+        if (token->type() != "ID")
+        {
+            m_Output.push_back(token);
+            continue;
         }
-        else if (token->lexeme() == "#endif")
+
+        SymbolPtr &symbol = symbols[id++];
+        if (symbol.isNull())
         {
-            if (!m_IfPreproc)
-                printf("#endif without #if\n");
-            m_IfPreproc = false;
+            m_Output.push_back(token);
         }
-        else if (token->lexeme() == "#include")
+        else if (m_Expander.isDefined(token->lexeme()) || symbol.use() == EU_ID)
         {
-            if (tokens[i]->type() != "STRING")
+            // An identifier may name another macro, so it is rescanned
+            i = expandInvocation(window, size, i, id);
+        }
+        else
+        {
+            // A macro without a value is replaced by nothing
+            if (symbol.constData())
+                m_Output.push_back(new Token(symbol.constData(),
+                                       symbol.use() == EU_ID ? "ID" : "CONSTANT",
+                                       token->line()));
+            delete token;
+        }
+    }
+}
+
+/*!
+ * \brief Takes the parameter list of a function-like macro being defined.
+ * \param line          The line of the #define, which the list must end on.
+ * \param parameters    Receives the names of the parameters.
+ * \return true if the list, from its '(' to its ')', was taken; otherwise
+ *         false.
+ */
+bool Preprocessor::takeParameters(int line, std::vector<std::string> &parameters)
+{
+    delete takeToken();
+
+    bool expectName = true;
+    while (peekToken() && peekToken()->line() == line &&
+           peekToken()->type() != "PREPROCESSOR")
+    {
+        Token *token = takeToken();
+        std::string type = token->type();
+        std::string lexeme = token->lexeme();
+        delete token;
+
+        if (type == ")" && (!expectName || parameters.empty()))
+            return true;
+        if (expectName != (type == "ID"))
+            return false;
+        if (expectName)
+            parameters.push_back(lexeme);
+        else if (type != ",")
+            return false;
+        expectName = !expectName;
+    }
+    return false;
+}
+
+/*!
+ * \brief Expands the invocation of a macro held by the expander, or of one
+ *        whose value is an identifier, and queues the expansion for output.
+ * \param window    The tokens being replaced.
+ * \param size      The number of tokens in the window.
+ * \param index     The index of the macro's name in the window.
+ * \param id        The number of identifiers of the window looked at so far,
+ *                  advanced past those the invocation takes.
+ * \return The index of the last token of the window the invocation took.
+ *
+ * The arguments of a function-like macro are taken from the rest of the
+ * window, then from the innermost source. Without a following '(' its name is
+ * an identifier like any other. A function-like macro ending the expansion is
+ * invoked in turn, with the tokens after the invocation, unless the expansion
+ * is its own.
+ */
+int Preprocessor::expandInvocation(Token **window, int size, int index, int &id)
+{
+    Token *name = window[index];
+    int next = index + 1;
+
+    for (;;)
+    {
+        TokenList invocation;
+        if (m_Expander.isFunctionLike(name->lexeme()))
+        {
+            Token *open = next < size ? window[next] : peekToken();
+            if (!open || open->type() != "(")
             {
-                printf("#include expects \"FILENAME\"\n");
-                continue;
+                m_Output.push_back(name);
+                return next - 1;
             }
 
-            // Get include path token
-            Token *path = tokens[i];
-            tokens.remove(path);
-
-            // Use lexical analyzer to tokenize included file
-            Lex lex(m_SymbolTable);
-            const char *filename = path->lexeme().substr(1, path->lexeme().length() - 2).c_str();
-            delete path;
+            for (int depth = 0; ; )
+            {
+                Token *token = 0;
+                if (next < size)
+                {
+                    token = window[next++];
+                    if (token->type() == "ID")
+                        id++;
+                }
+                else if (peekToken() && peekToken()->type() != "PREPROCESSOR")
+                {
+                    token = takeToken();
+                }
 
-            for (size_t j = 0; j < IncludeStack.size(); j++)
-                if (IncludeStack[j] == filename)
+                if (!token)
                 {
-                    printf("prevented duplicate include of %s\n", filename);
-                    continue;
+                    printf("unterminated argument list invoking macro %s\n",
+                           name->lexeme().c_str());
+                    break;
                 }
 
-            IncludeStack.push_back(filename);
-            TokenList *includedTokens = lex.tokenizeFile(filename);
-            process(*includedTokens);
-            includedTokens->move(&tokens, tokens[i]);
+                invocation.add(token);
+                if (token->type() == "(")
+                    depth++;
+                else if (token->type() == ")" && --depth == 0)
+                    break;
+            }
+        }
+
+        TokenBuffer *buffer = new TokenBuffer(invocation);
+        TokenSequence tokens, expansion;
+        tokens.append(buffer);
+        buffer->release();
+
+        std::vector<TokenSequence> arguments;
+        TokenSequence::iterator end = tokens.begin();
+        bool invoked = !m_Expander.isFunctionLike(name->lexeme()) ||
+                       MacroExpander::collectArguments(end, tokens.end(), arguments);
 
-            if (!IncludeStack.empty())
-                IncludeStack.pop_back();
+        if (!invoked || !m_Expander.expand(name->lexeme(), arguments, expansion))
+        {
+            // Leave the invocation as it was written
+            m_Output.push_back(name);
+            for (TokenSequence::iterator it = tokens.begin(); it != tokens.end(); ++it)
+                m_Output.push_back(new Token(**it));
+            return next - 1;
         }
 
-        delete token;
+        // A function-like macro ending the expansion may take its arguments
+        // from the tokens after the invocation
+        TokenSequence::iterator last;
+        bool chained =
+            !m_Expander.trailingInvocation(expansion, name->lexeme(), last).empty();
+        if (!chained)
+            last = expansion.end();
+
+        for (TokenSequence::iterator it = expansion.begin(); it != last; ++it)
+            m_Output.push_back(new Token(**it));
+        delete name;
+
+        if (!chained)
+            return next - 1;
+        name = new Token(**last);
     }
 }
 
 /*!
- * \brief   Private method removes tokens until and #endif token is encountered.
- * \param i         The index of the current token.
- * \param tokens    The list of tokens.
- * \return  true if endif encountered; otherwise false.
+ * \brief Tells how a raw token changes the nesting of conditionals.
+ * \return 1 for #ifdef or #ifndef, -1 for #endif, otherwise 0.
  */
-bool Preprocessor::removeTokensUntilEndif(int i, TokenList &tokens)
+static int conditionalNesting(const Token *token)
 {
-    bool bEndif = tokens[i]->lexeme() == "#endif";
-    while (i < tokens.length() && !bEndif)
+    if (token->type() != "PREPROCESSOR")
+        return 0;
+
+    std::string directive = token->lexeme();
+    if (directive == "#ifdef" || directive == "#ifndef")
+        return 1;
+    return directive == "#endif" ? -1 : 0;
+}
+
+/*!
+ * \brief Skips the innermost source through the #endif closing an inactive
+ *        region, along with every conditional nested in the region.
+ * \return  true if the #endif was found; otherwise false.
+ *
+ * A file being lexed is skipped by its lexer, which reads raw lines rather
+ * than tokens. The tokens of a cached include are stepped over without being
+ * copied, and those of a list are deleted.
+ */
+bool Preprocessor::skipConditional()
+{
+    Source *source = m_Sources.back();
+    int depth = 0;
+
+    // A token read ahead is the first of the region
+    if (Token *token = source->m_pPeekedToken)
     {
-        Token *token = tokens[i];
-        tokens.remove(tokens[i]);
+        source->m_pPeekedToken = 0;
+        depth = conditionalNesting(token);
         delete token;
-        bEndif = tokens[i]->lexeme() == "#endif";
+        if (depth < 0)
+            return true;
     }
 
-    if (bEndif)
+    if (source->m_pLex)
+        return source->m_pLex->skipConditional(depth);
+
+    if (source->m_pBuffer)
     {
-        Token *endif = tokens[i];
-        tokens.remove(tokens[i]);
-        delete endif;
+        while (source->m_BufferIndex < source->m_pBuffer->length())
+        {
+            depth += conditionalNesting(
+                source->m_pBuffer->token(source->m_BufferIndex++));
+            if (depth < 0)
+                return true;
+        }
+        return false;
     }
 
-    return bEndif;
+    while (Token *token = takeToken())
+    {
+        depth += conditionalNesting(token);
+        delete token;
+        if (depth < 0)
+            return true;
+    }
+    return false;
 }
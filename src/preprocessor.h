@@ -9,10 +9,18 @@
  */
 #ifndef PREPROCESSOR_H
 #define PREPROCESSOR_H
+#include "includecache.h"
+#include "macroexpander.h"
+#include <deque>
+#include <iosfwd>
+#include <set>
 #include <vector>
 #include <string>
 
 /// Forward declarations
+class Lex;
+class Token;
+class TokenBuffer;
 class TokenList;
 class SymbolTable;
 
@@ -21,28 +29,150 @@ class SymbolTable;
  *
  * The scope of preprocessor symbols is global, so there will be no new scopes
  * added to the symbol table.
+ *
+ * The preprocessor pulls raw tokens from a stack of sources: files being
+ * lexed, the innermost include on top, or a list being processed. Directives
+ * are acted on and macros replaced as the tokens arrive, and only the final
+ * tokens are handed out, so a file of any size is preprocessed without ever
+ * holding its tokens in a list.
+ *
+ * Included files are read from an include cache instead, which lexes each
+ * file once however often it is included. The cache may be shared with other
+ * preprocessors.
+ *
+ * A #define spans the rest of its line. A macro of one identifier or constant
+ * is kept in the symbol table as its value; longer and function-like macros
+ * are held by a MacroExpander, which also rescans values which are
+ * identifiers.
  */
 class Preprocessor
 {
 public:
     /// Instantiates a new preprocessor object.
-    Preprocessor(SymbolTable &symbolTable);
+    Preprocessor(SymbolTable &symbolTable, IncludeCache *includeCache = 0);
+
+    /// Closes any open sources and deletes any tokens not handed out.
+    ~Preprocessor();
+
+    /// Starts preprocessing the file at \p filename.
+    bool openFile(const char *filename);
+
+    /// Returns the next preprocessed token, or NULL at the end of the input.
+    Token *nextToken();
 
     /// Process a list of tokens, removing and acting on preprocess directives.
     void process(TokenList &tokens);
 
 private:
-    /// Removes tokens until #endif is encountered.
-    bool removeTokensUntilEndif(int i, TokenList &tokens);
+    /*!
+     * \brief   The Source struct is a source of raw tokens: a file being
+     *          lexed, the cached tokens of an included file, or a list of
+     *          tokens being drained.
+     */
+    struct Source
+    {
+        /// The lexer of a file, or NULL.
+        Lex *m_pLex;
+
+        /// The file being lexed, or NULL.
+        std::ifstream *m_pStream;
+
+        /// The name of the file, which the lexer reports errors against.
+        std::string m_Filename;
+
+        /// The cached tokens of an included file, or NULL.
+        TokenBuffer *m_pBuffer;
+
+        /// The index of the next token of \p m_pBuffer.
+        int m_BufferIndex;
+
+        /// The list being drained, or NULL.
+        TokenList *m_pTokens;
+
+        /// The next raw token, once peeked at, or NULL.
+        Token *m_pPeekedToken;
+
+        /// The identity of the file, if it is on the include stack.
+        FileId m_File;
+
+        /// Whether the file is on the include stack, which a list never is.
+        bool m_OnIncludeStack;
+    };
+
+    /*!
+     * \brief   The Conditional struct is an #ifdef or #ifndef whose region is
+     *          being read, awaiting its #endif.
+     */
+    struct Conditional
+    {
+        /// The directive which opened the region.
+        std::string m_Directive;
+
+        /// The number of sources open at the directive, so that the region is
+        /// closed in the file it was opened in.
+        size_t m_SourceDepth;
+    };
+
+    // Preprocessors own their sources and are not copyable
+    Preprocessor(const Preprocessor&);
+    Preprocessor& operator=(const Preprocessor&);
+
+    /// Pushes a file to read raw tokens from.
+    bool pushFile(const std::string &filename);
+
+    /// Pushes the cached tokens of an included file.
+    bool pushInclude(const std::string &filename);
+
+    /// Pops the innermost source, once it is exhausted.
+    void closeSource();
+
+    /// Returns the next raw token of the innermost source, without taking it.
+    Token *peekToken();
+
+    /// Takes the next raw token of the innermost source.
+    Token *takeToken();
+
+    /// Acts on a directive, taking the tokens it applies to.
+    void processDirective(Token *token);
+
+    /// Replaces the macros among the identifiers up to the next directive.
+    void replaceMacros();
+
+    /// Takes the parameter list of a function-like macro being defined.
+    bool takeParameters(int line, std::vector<std::string> &parameters);
+
+    /// Expands the invocation of a macro at \p index of \p window.
+    int expandInvocation(Token **window, int size, int index, int &id);
+
+    /// Skips the innermost source through the #endif closing an inactive region.
+    bool skipConditional();
 
     /// A reference to a populated symbol table.
     SymbolTable &m_SymbolTable;
 
-    /// A dynamic array of included files.
-    std::vector<std::string> IncludeStack;
+    /// The cache included files are read from.
+    IncludeCache *m_pIncludeCache;
+
+    /// Whether the preprocessor created the cache, and so deletes it.
+    bool m_OwnsIncludeCache;
+
+    /// The macros whose replacement is more than one token.
+    MacroExpander m_Expander;
+
+    /// The sources being read, the innermost last.
+    std::vector<Source*> m_Sources;
+
+    /// Preprocessed tokens not yet handed out.
+    std::deque<Token*> m_Output;
+
+    /// The files being read, outermost first, by identity.
+    std::vector<FileId> IncludeStack;
+
+    /// The files which asked, by #pragma once, to be read only once.
+    std::set<FileId> m_OnceFiles;
 
-    /// Flag to track whether we are within a preprocessor.
-    bool m_IfPreproc;
+    /// The conditionals whose regions are being read, the innermost last.
+    std::vector<Conditional> m_Conditionals;
 };
 
 #endif // PREPROCESSOR_H
@@ -10,6 +10,22 @@
 #include "symbol.h"
 #include <string.h>
 
+/*!
+ * \brief   Hashes a symbol name.
+ * \param   name    The name to hash.
+ * \return  The 32-bit FNV-1a hash of \p name.
+ */
+unsigned int hashSymbolName(const char *name)
+{
+    unsigned int hash = 2166136261u;
+    for (const unsigned char *ch = (const unsigned char*)name; *ch; ch++)
+    {
+        hash ^= *ch;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 /*!
  * \brief   Creates a new symbol object and initializes its data members.
  * \param   name        The name of the symbol.
@@ -18,7 +34,8 @@
  * \param   constData   The constant data which the symbol may represent.
  */
 Symbol::Symbol(const char *name, E_TYPE type, E_USE use, const char *constData)
-    :m_pNextSymbol(0), m_pPrevSymbol(0), m_pName(0), m_ConstData(0)
+    :m_Scope(0), m_pName(0), m_pShadowedSymbol(0), m_ConstData(0),
+     m_pNextSymbol(0), m_pPrevSymbol(0)
 {
     m_pName = new char[strlen(name) + 1];
 #if defined(__GNUC__)
@@ -26,6 +43,7 @@ Symbol::Symbol(const char *name, E_TYPE type, E_USE use, const char *constData)
 #elif defined(_MSC_VER)
     strcpy_s(m_pName, strlen(name) + 1, name);
 #endif
+    m_Hash = hashSymbolName(name);
     m_Type = type;
     m_Use = use;
 
@@ -40,6 +58,25 @@ Symbol::Symbol(const char *name, E_TYPE type, E_USE use, const char *constData)
     }
 }
 
+/*!
+ * \brief   Creates a new symbol object around strings it does not copy.
+ * \param   name        The name of the symbol, kept in an arena.
+ * \param   hash        The hash of \p name.
+ * \param   type        The type of the symbol.
+ * \param   use         The use for the symbol.
+ * \param   constData   The constant data, kept in an arena, or NULL.
+ *
+ * A symbol built this way, normally in the same block of an arena as its
+ * strings, must not be destroyed. It is released with the arena instead.
+ */
+Symbol::Symbol(char *name, unsigned int hash, E_TYPE type, E_USE use,
+               char *constData)
+    :m_Hash(hash), m_Type(type), m_Use(use), m_Scope(0), m_pName(name),
+     m_pShadowedSymbol(0), m_ConstData(constData), m_pNextSymbol(0),
+     m_pPrevSymbol(0)
+{
+}
+
 /*!
  * \brief Destroys a Symbol object.
  *
@@ -81,6 +118,12 @@ char* Symbol::name() const
     return m_pName;
 }
 
+/// Returns the hash of the symbol's name.
+unsigned int Symbol::hash() const
+{
+    return m_Hash;
+}
+
 /// Returns the type of the symbol.
 E_TYPE Symbol::type() const
 {
@@ -122,3 +165,27 @@ void Symbol::setNextSymbol(Symbol *nextSymbol)
 {
     m_pNextSymbol = nextSymbol;
 }
+
+/// Gets the symbol of the same name which this symbol hides.
+Symbol* Symbol::shadowedSymbol() const
+{
+    return m_pShadowedSymbol;
+}
+
+/// Sets the symbol of the same name which this symbol hides.
+void Symbol::setShadowedSymbol(Symbol *shadowedSymbol)
+{
+    m_pShadowedSymbol = shadowedSymbol;
+}
+
+/// Gets the depth of the scope the symbol was declared in.
+int Symbol::scope() const
+{
+    return m_Scope;
+}
+
+/// Sets the depth of the scope the symbol was declared in.
+void Symbol::setScope(int scope)
+{
+    m_Scope = scope;
+}
@@ -10,6 +10,18 @@
 #ifndef SYMBOL_H
 #define SYMBOL_H
 
+/// Hints that the memory at \p address will soon be read, so a lookup can
+/// start its cache misses before it needs the data.
+#if defined(__GNUC__)
+#define SYMBOL_PREFETCH(address)    __builtin_prefetch(address)
+#elif defined(_MSC_VER)
+#include <xmmintrin.h>
+#define SYMBOL_PREFETCH(address) \
+    _mm_prefetch((const char*)(address), _MM_HINT_T0)
+#else
+#define SYMBOL_PREFETCH(address)
+#endif
+
 /*!
  * \brief The E_TYPE enum identifies the type of symbol.
  */
@@ -36,6 +48,28 @@ enum E_USE
     EU_MACRO
 };
 
+/*!
+ * \brief   The SymbolDefinition struct describes a symbol to be added, so that
+ *          tables of symbols can be built at compile time and added at once.
+ */
+struct SymbolDefinition
+{
+    /// The name of the symbol.
+    const char *m_pName;
+
+    /// The type of the symbol.
+    E_TYPE m_Type;
+
+    /// The use for the symbol.
+    E_USE m_Use;
+
+    /// The constant data the symbol may contain, or NULL.
+    const char *m_pConstData;
+};
+
+/// Hashes a symbol name for the symbol table (32-bit FNV-1a).
+unsigned int hashSymbolName(const char *name);
+
 /*!
  * \brief   The Symbol class contains data to represent a symbol in the symbol
  *          table. Do NOT delete a pointer to a symbol once it has been added to
@@ -47,11 +81,16 @@ public:
     /// Creates a new symbol object.
     Symbol(const char *name, E_TYPE type, E_USE use, const char *constData);
 
+    /// Creates a new symbol object which adopts strings kept in an arena.
+    Symbol(char *name, unsigned int hash, E_TYPE type, E_USE use,
+           char *constData);
+
     /// Deletes a symbol object.
     ~Symbol();
 
     /// Getters and setters
     char* name() const;
+    unsigned int hash() const;
     E_TYPE type() const;
     E_USE use() const;
     char* constData() const;
@@ -59,16 +98,17 @@ public:
     void setPrevSymbol(Symbol *prevSymbol);
     Symbol *nextSymbol() const;
     void setNextSymbol(Symbol *nextSymbol);
+    Symbol *shadowedSymbol() const;
+    void setShadowedSymbol(Symbol *shadowedSymbol);
+    int scope() const;
+    void setScope(int scope);
 
 private:
-    /// Pointer to the next symbol in the list
-    Symbol *m_pNextSymbol;
+    // Fields read by every lookup come first, so that a symbol whose hash
+    // matched costs one cache line to compare and return.
 
-    /// Pointer to the previous symbol in the list.
-    Symbol *m_pPrevSymbol;
-
-    /// The name of the symbol.
-    char *m_pName;
+    /// The hash of the symbol's name, computed once.
+    unsigned int m_Hash;
 
     /// The type of the symbol.
     E_TYPE m_Type;
@@ -76,8 +116,25 @@ private:
     /// The use for the symbol.
     E_USE  m_Use;
 
+    /// The depth of the scope the symbol was declared in.
+    int m_Scope;
+
+    /// The name of the symbol.
+    char *m_pName;
+
+    /// The symbol of the same name in an outer scope, which this one hides.
+    Symbol *m_pShadowedSymbol;
+
+    // Fields only read when the symbol is used or its scope changes.
+
     /// The constant data the symbol may contain.
     char *m_ConstData;
+
+    /// Pointer to the next symbol in the list
+    Symbol *m_pNextSymbol;
+
+    /// Pointer to the previous symbol in the list.
+    Symbol *m_pPrevSymbol;
 };
 
 /*!
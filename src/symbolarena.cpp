@@ -0,0 +1,236 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        symbolarena.cpp
+ *
+ * \brief       Defines the methods of the SymbolArena class.
+ */
+#include "symbolarena.h"
+#include <string.h>
+#include <stdint.h>
+#include <new>
+
+/// The number of bytes in an arena's first chunk.
+#define FIRST_CHUNK_CAPACITY    4096
+
+/// The largest number of bytes in one chunk, unless one allocation needs more.
+#define MAX_CHUNK_CAPACITY      65536
+
+/// Every allocation starts on a multiple of this many bytes.
+#define ARENA_ALIGNMENT         alignof(std::max_align_t)
+
+/// Rounds \p size up to a multiple of ARENA_ALIGNMENT.
+static size_t alignArenaSize(size_t size)
+{
+    return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+/// Returns the first byte of a chunk's memory.
+#define CHUNK_MEMORY(chunk) \
+    (reinterpret_cast<char*>(chunk) + alignArenaSize(sizeof(*(chunk))))
+
+/*!
+ * \brief   Instantiates an empty arena. No memory is allocated until the first
+ *          request.
+ */
+SymbolArena::SymbolArena()
+    :m_pFirstChunk(0), m_pChunk(0), m_Used(0)
+{
+}
+
+/*!
+ * \brief   Destroys the arena, freeing every chunk and whatever is in them.
+ */
+SymbolArena::~SymbolArena()
+{
+    Chunk *chunk = m_pFirstChunk, *nextChunk = 0;
+    while (chunk)
+    {
+        nextChunk = chunk->m_pNextChunk;
+        ::operator delete(chunk);
+        chunk = nextChunk;
+    }
+}
+
+/*!
+ * \brief   Bumps \p size bytes out of the current chunk.
+ * \param   size    The number of bytes wanted.
+ * \return  Pointer to memory aligned for any type.
+ *
+ * When the current chunk is full, the next chunk is reused if it is large
+ * enough. Otherwise a new chunk, twice the size of the last, is linked in
+ * ahead of it.
+ */
+void* SymbolArena::allocate(size_t size)
+{
+    size = alignArenaSize(size ? size : 1);
+
+    if (!m_pChunk || m_Used + size > m_pChunk->m_Capacity)
+    {
+        Chunk *next = m_pChunk ? m_pChunk->m_pNextChunk : m_pFirstChunk;
+        if (!next || next->m_Capacity < size)
+        {
+            size_t capacity = m_pChunk ? m_pChunk->m_Capacity * 2
+                                       : FIRST_CHUNK_CAPACITY;
+            if (capacity > MAX_CHUNK_CAPACITY)
+                capacity = MAX_CHUNK_CAPACITY;
+            if (capacity < size)
+                capacity = size;
+
+            Chunk *chunk = static_cast<Chunk*>(
+                ::operator new(alignArenaSize(sizeof(Chunk)) + capacity));
+            chunk->m_pNextChunk = next;
+            chunk->m_Capacity = capacity;
+            if (m_pChunk)
+                m_pChunk->m_pNextChunk = chunk;
+            else
+                m_pFirstChunk = chunk;
+            next = chunk;
+        }
+
+        m_pChunk = next;
+        m_Used = 0;
+    }
+
+    void *memory = CHUNK_MEMORY(m_pChunk) + m_Used;
+    m_Used += size;
+    return memory;
+}
+
+/*!
+ * \brief   Copies a NUL-terminated string into the arena.
+ * \param   str     The string to copy.
+ * \return  The copy.
+ */
+char* SymbolArena::copyString(const char *str)
+{
+    size_t length = strlen(str) + 1;
+    char *copy = static_cast<char*>(allocate(length));
+    memcpy(copy, str, length);
+    return copy;
+}
+
+/*!
+ * \brief   Gives back a block for reuse() to hand out again.
+ * \param   memory  Memory got from allocate() or reuse(), no longer in use.
+ * \param   size    The number of bytes asked for when \p memory was got.
+ *
+ * The block stays released until it is reused, or until a rewind to a mark
+ * taken before it was allocated.
+ */
+void SymbolArena::release(void *memory, size_t size)
+{
+    size = alignArenaSize(size ? size : 1);
+    void *&first = m_FreeBlocks[size];
+    *static_cast<void**>(memory) = first;
+    first = memory;
+}
+
+/*!
+ * \brief   Gets a block of \p size bytes, preferring one given back by
+ *          release().
+ * \param   size    The number of bytes wanted.
+ * \return  Pointer to memory aligned for any type.
+ */
+void* SymbolArena::reuse(size_t size)
+{
+    size = alignArenaSize(size ? size : 1);
+    if (!m_FreeBlocks.empty())
+    {
+        std::unordered_map<size_t, void*>::iterator blocks = m_FreeBlocks.find(size);
+        if (blocks != m_FreeBlocks.end())
+        {
+            void *memory = blocks->second;
+            blocks->second = *static_cast<void**>(memory);
+            if (!blocks->second)
+                m_FreeBlocks.erase(blocks);
+            return memory;
+        }
+    }
+    return allocate(size);
+}
+
+/*!
+ * \brief   Gets the number of bytes handed out by bumping, whether or not they
+ *          have been released since.
+ * \return  The bytes of every chunk before the one being bumped, and the
+ *          bytes used in that one.
+ */
+size_t SymbolArena::size() const
+{
+    size_t size = m_Used;
+    for (Chunk *chunk = m_pFirstChunk; chunk && chunk != m_pChunk;
+         chunk = chunk->m_pNextChunk)
+        size += chunk->m_Capacity;
+    return m_pChunk ? size : 0;
+}
+
+/*!
+ * \brief   Gets the arena's current position.
+ * \return  A mark which rewind() returns the arena to.
+ */
+SymbolArena::Mark SymbolArena::mark() const
+{
+    Mark mark;
+    mark.m_pChunk = m_pChunk;
+    mark.m_Used = m_Used;
+    return mark;
+}
+
+/*!
+ * \brief   Releases everything allocated after \p mark was taken. Nothing is
+ *          destroyed; objects in the released memory must not need it.
+ * \param   mark    A mark taken from this arena, which has not since been
+ *                  rewound past.
+ */
+void SymbolArena::rewind(const Mark &mark)
+{
+    // Released blocks past the mark are handed out by bumping from now on
+    for (std::unordered_map<size_t, void*>::iterator blocks =
+             m_FreeBlocks.begin(); blocks != m_FreeBlocks.end(); )
+    {
+        void **link = &blocks->second;
+        while (*link)
+        {
+            if (isBefore(mark, *link))
+                link = static_cast<void**>(*link);
+            else
+                *link = *static_cast<void**>(*link);
+        }
+
+        if (blocks->second)
+            ++blocks;
+        else
+            blocks = m_FreeBlocks.erase(blocks);
+    }
+
+    m_pChunk = mark.m_pChunk;
+    m_Used = mark.m_Used;
+}
+
+/*!
+ * \brief   Tells whether memory of the arena lies before a mark.
+ * \param   mark    A mark taken from this arena.
+ * \param   memory  Memory got from this arena.
+ * \return  true if \p memory was allocated before \p mark was taken.
+ *
+ * Chunks are listed in the order they are bumped through, so whatever lies in
+ * a chunk ahead of the mark's, or below its use of its own, came first.
+ */
+bool SymbolArena::isBefore(const Mark &mark, const void *memory) const
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(memory);
+    for (Chunk *chunk = m_pFirstChunk; chunk && mark.m_pChunk;
+         chunk = chunk->m_pNextChunk)
+    {
+        uintptr_t start = reinterpret_cast<uintptr_t>(CHUNK_MEMORY(chunk));
+        bool inChunk = address >= start && address < start + chunk->m_Capacity;
+        if (chunk == mark.m_pChunk)
+            return inChunk && address < start + mark.m_Used;
+        if (inChunk)
+            return true;
+    }
+    return false;
+}
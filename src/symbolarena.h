@@ -0,0 +1,100 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        symbolarena.h
+ *
+ * \brief       Declares the structure of the SymbolArena class.
+ */
+#ifndef SYMBOLARENA_H
+#define SYMBOLARENA_H
+
+#include <cstddef>
+#include <unordered_map>
+
+/*!
+ * \brief   The SymbolArena class hands out memory for symbols and their
+ *          strings by bumping a pointer through chunks of memory. It is an
+ *          implementation detail of SymbolTable.
+ *
+ * Memory is mostly freed wholesale. A mark records the arena's position, and
+ * rewinding to it releases everything allocated since in one step. Chunks are
+ * kept after a rewind and reused, so a table that pushes and pops scopes
+ * settles into not calling the heap at all.
+ *
+ * Memory which is never rewound past, such as that of the global scope, may
+ * also be released piecemeal. Released blocks are kept on a free list per
+ * size, and reuse() hands them out again before bumping.
+ */
+class SymbolArena
+{
+private:
+    /// Header of a chunk; its memory follows it.
+    struct Chunk
+    {
+        /// The next chunk to bump into once this one is full.
+        Chunk *m_pNextChunk;
+
+        /// The number of bytes the chunk holds.
+        size_t m_Capacity;
+    };
+
+public:
+    /// A position in the arena to rewind to.
+    struct Mark
+    {
+        /// The chunk being bumped, or NULL before the first allocation.
+        Chunk *m_pChunk;
+
+        /// The number of bytes used in the chunk.
+        size_t m_Used;
+    };
+
+    SymbolArena();
+    ~SymbolArena();
+
+    /// Gets \p size bytes, aligned for any type.
+    void *allocate(size_t size);
+
+    /// Copies a string into the arena.
+    char *copyString(const char *str);
+
+    /// Gives back \p size bytes got at \p memory, for reuse() to hand out.
+    void release(void *memory, size_t size);
+
+    /// Gets \p size bytes given back by release(), or else allocates them.
+    void *reuse(size_t size);
+
+    /// Returns the number of bytes bumped out of the arena's chunks.
+    size_t size() const;
+
+    /// Returns the arena's current position.
+    Mark mark() const;
+
+    /// Releases everything allocated since \p mark was taken.
+    void rewind(const Mark &mark);
+
+private:
+    // Arenas own raw memory and are not copyable
+    SymbolArena(const SymbolArena&);
+    SymbolArena& operator=(const SymbolArena&);
+
+    /// Returns whether \p memory was allocated before \p mark was taken.
+    bool isBefore(const Mark &mark, const void *memory) const;
+
+    /// The first chunk of the arena.
+    Chunk *m_pFirstChunk;
+
+    /// The chunk being bumped, or NULL before the first allocation.
+    Chunk *m_pChunk;
+
+    /// The number of bytes used in the chunk being bumped.
+    size_t m_Used;
+
+    /// The first released block of each aligned size. Each block holds a
+    /// pointer to the next of its size.
+    std::unordered_map<size_t, void*> m_FreeBlocks;
+};
+
+#endif//SYMBOLARENA_H
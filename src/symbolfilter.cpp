@@ -0,0 +1,212 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        symbolfilter.cpp
+ *
+ * \brief       Defines the methods of the SymbolFilter class.
+ */
+#include "symbolfilter.h"
+#include "epochreclaimer.h"
+#include "symbol.h"
+
+/// The number of counters in a filter's first array.
+#define FIRST_FILTER_CAPACITY   1024
+
+/// The number of counters in a block; a hash's counters share one block.
+#define FILTER_BLOCK_SIZE       64
+
+/// The number of counters per name, below which the filter is crowded.
+#define FILTER_COUNTERS_PER_NAME    8
+
+/// The value at which a counter sticks.
+#define FILTER_COUNTER_MAX      255
+
+/*!
+ * \brief   Instantiates an empty filter. No counters are allocated until the
+ *          first name is added.
+ */
+SymbolFilter::SymbolFilter()
+    :m_pCounterArray(0), m_Count(0)
+{
+}
+
+/*!
+ * \brief   Destroys the filter and its counters.
+ */
+SymbolFilter::~SymbolFilter()
+{
+    deleteCounters(m_pCounterArray.load(std::memory_order_relaxed));
+}
+
+/*!
+ * \brief   Checks whether a name may be in the filter.
+ * \param   hash    The hash of the name.
+ * \return  false if the name is certainly not in the filter, otherwise true.
+ */
+bool SymbolFilter::mayContain(unsigned int hash) const
+{
+    const CounterArray *counters =
+        m_pCounterArray.load(std::memory_order_acquire);
+    if (!counters)
+        return false;
+
+    unsigned int first, second;
+    counterIndexes(counters, hash, &first, &second);
+    return counters->m_pCounters[first].load(std::memory_order_relaxed) &&
+           counters->m_pCounters[second].load(std::memory_order_relaxed);
+}
+
+/*!
+ * \brief   Prefetches the block of counters a query for a name will read.
+ * \param   hash    The hash of the name.
+ */
+void SymbolFilter::prefetch(unsigned int hash) const
+{
+    const CounterArray *counters =
+        m_pCounterArray.load(std::memory_order_acquire);
+    if (!counters)
+        return;
+
+    unsigned int first, second;
+    counterIndexes(counters, hash, &first, &second);
+    SYMBOL_PREFETCH(&counters->m_pCounters[first]);
+}
+
+/*!
+ * \brief   Counts a name into the filter.
+ * \param   hash    The hash of the name.
+ */
+void SymbolFilter::add(unsigned int hash)
+{
+    CounterArray *counters = m_pCounterArray.load(std::memory_order_relaxed);
+    if (!counters)
+    {
+        counters = newCounters(FIRST_FILTER_CAPACITY);
+        m_pCounterArray.store(counters, std::memory_order_release);
+    }
+
+    increment(counters, hash);
+    m_Count++;
+}
+
+/*!
+ * \brief   Counts a name, which was added before, out of the filter.
+ * \param   hash    The hash of the name.
+ */
+void SymbolFilter::remove(unsigned int hash)
+{
+    CounterArray *counters = m_pCounterArray.load(std::memory_order_relaxed);
+    unsigned int index[2];
+    counterIndexes(counters, hash, &index[0], &index[1]);
+
+    for (int i = 0; i < 2; i++)
+    {
+        std::atomic<unsigned char> &counter = counters->m_pCounters[index[i]];
+        unsigned char count = counter.load(std::memory_order_relaxed);
+        if (count != FILTER_COUNTER_MAX)
+            counter.store(count - 1, std::memory_order_relaxed);
+    }
+    m_Count--;
+}
+
+/*!
+ * \brief   Checks whether the filter has too few counters per name to reject
+ *          most misses.
+ * \return  true if the filter should be rebuilt larger.
+ */
+bool SymbolFilter::isCrowded() const
+{
+    const CounterArray *counters =
+        m_pCounterArray.load(std::memory_order_relaxed);
+    return counters &&
+           (unsigned int)m_Count * FILTER_COUNTERS_PER_NAME > counters->m_Mask;
+}
+
+/*!
+ * \brief   Builds a filter large enough for \p hashes, then publishes it.
+ * \param   hashes      The hash of every name the filter should hold.
+ * \param   concurrent  Whether readers may be querying the old counters,
+ *                      which are then freed only once none can be.
+ */
+void SymbolFilter::rebuild(const std::vector<unsigned int> &hashes,
+                           bool concurrent)
+{
+    unsigned int capacity = FIRST_FILTER_CAPACITY;
+    while (capacity < hashes.size() * FILTER_COUNTERS_PER_NAME * 2)
+        capacity *= 2;
+
+    CounterArray *counters = newCounters(capacity);
+    for (size_t i = 0; i < hashes.size(); i++)
+        increment(counters, hashes[i]);
+    m_Count = (int)hashes.size();
+
+    CounterArray *oldCounters =
+        m_pCounterArray.exchange(counters, std::memory_order_acq_rel);
+    if (oldCounters && concurrent)
+        EpochReclaimer::synchronize();
+    deleteCounters(oldCounters);
+}
+
+/*!
+ * \brief   Allocates zeroed counters.
+ * \param   capacity    The number of counters, a power of two.
+ * \return  The new counters.
+ */
+SymbolFilter::CounterArray *SymbolFilter::newCounters(unsigned int capacity)
+{
+    CounterArray *counters = new CounterArray;
+    counters->m_Mask = capacity - 1;
+    counters->m_pCounters = new std::atomic<unsigned char>[capacity]();
+    return counters;
+}
+
+/*!
+ * \brief   Frees counters, if there are any.
+ * \param   counters    The counters to free.
+ */
+void SymbolFilter::deleteCounters(CounterArray *counters)
+{
+    if (!counters)
+        return;
+
+    delete []counters->m_pCounters;
+    delete counters;
+}
+
+/*!
+ * \brief   Picks a block from the low bits of \p hash, then two counters within
+ *          it from the low and, remixed, the high bits.
+ * \param   counters    The counters the indexes are into.
+ * \param   hash        The hash of a name.
+ * \param   first       Receives the index of the first counter.
+ * \param   second      Receives the index of the second counter.
+ */
+void SymbolFilter::counterIndexes(const CounterArray *counters,
+                                  unsigned int hash, unsigned int *first,
+                                  unsigned int *second)
+{
+    *first = hash & counters->m_Mask;
+    *second = (*first & ~(FILTER_BLOCK_SIZE - 1u)) |
+              ((hash * 0x9E3779B1u) >> 26);
+}
+
+/*!
+ * \brief   Increments both counters of \p hash, leaving stuck ones alone.
+ * \param   counters    The counters to update.
+ * \param   hash        The hash of a name.
+ */
+void SymbolFilter::increment(CounterArray *counters, unsigned int hash)
+{
+    unsigned int index[2];
+    counterIndexes(counters, hash, &index[0], &index[1]);
+
+    for (int i = 0; i < 2; i++)
+    {
+        std::atomic<unsigned char> &counter = counters->m_pCounters[index[i]];
+        unsigned char count = counter.load(std::memory_order_relaxed);
+        if (count != FILTER_COUNTER_MAX)
+            counter.store(count + 1, std::memory_order_relaxed);
+    }
+}
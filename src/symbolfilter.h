@@ -0,0 +1,90 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        symbolfilter.h
+ *
+ * \brief       Declares the structure of the SymbolFilter class.
+ */
+#ifndef SYMBOLFILTER_H
+#define SYMBOLFILTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/*!
+ * \brief   The SymbolFilter class is a counting Bloom filter over name hashes.
+ *          It is an implementation detail of SymbolTable.
+ *
+ * mayContain() never answers false for a hash which was added and not yet
+ * removed, and usually answers false for any other. Both counters of a hash
+ * lie in one 64 byte block, so a query touches a single cache line. Counters
+ * which overflow stick at their maximum rather than wrap.
+ *
+ * The filter may be queried from any thread while one writer updates it.
+ */
+class SymbolFilter
+{
+public:
+    /// Creates an empty filter.
+    SymbolFilter();
+
+    /// Frees the filter's counters.
+    ~SymbolFilter();
+
+    /// Returns false if no name with \p hash can be in the filter.
+    bool mayContain(unsigned int hash) const;
+
+    /// Starts loading the counters of \p hash into the cache.
+    void prefetch(unsigned int hash) const;
+
+    /// Counts a name with \p hash into the filter.
+    void add(unsigned int hash);
+
+    /// Counts a name with \p hash out of the filter.
+    void remove(unsigned int hash);
+
+    /// Returns whether the filter holds too many names to stay selective.
+    bool isCrowded() const;
+
+    /// Replaces the filter with a larger one holding \p hashes.
+    void rebuild(const std::vector<unsigned int> &hashes, bool concurrent);
+
+private:
+    /// The counters, published to readers as one.
+    struct CounterArray
+    {
+        /// The number of counters, a power of two, less one.
+        unsigned int m_Mask;
+
+        /// The counters.
+        std::atomic<unsigned char> *m_pCounters;
+    };
+
+    // Filters own their counters and are not copyable
+    SymbolFilter(const SymbolFilter&);
+    SymbolFilter& operator=(const SymbolFilter&);
+
+    /// Creates a zeroed array of \p capacity counters.
+    static CounterArray *newCounters(unsigned int capacity);
+
+    /// Frees an array of counters.
+    static void deleteCounters(CounterArray *counters);
+
+    /// Finds the two counters of \p hash.
+    static void counterIndexes(const CounterArray *counters, unsigned int hash,
+                               unsigned int *first, unsigned int *second);
+
+    /// Increments the counters of \p hash, unless they are stuck.
+    static void increment(CounterArray *counters, unsigned int hash);
+
+    /// The counters.
+    std::atomic<CounterArray*> m_pCounterArray;
+
+    /// The number of names counted in.
+    int m_Count;
+};
+
+#endif//SYMBOLFILTER_H
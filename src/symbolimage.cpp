@@ -0,0 +1,316 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        symbolimage.cpp
+ *
+ * \brief       Defines the methods of the SymbolImage class.
+ */
+#include "symbolimage.h"
+#include "symbolsnapshot.h"
+#include <stdio.h>
+#include <string.h>
+#include <new>
+#include <vector>
+#if defined(_MSC_VER)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// Identifies an image file ("LLCS"), read back in the byte order it was
+/// written in.
+#define IMAGE_MAGIC         0x4C4C4353u
+
+/// The version of the image format.
+#define IMAGE_VERSION       1u
+
+/// The number of entries in the smallest image hash table.
+#define IMAGE_MIN_CAPACITY  16u
+
+/// Marks an entry's string as absent.
+#define IMAGE_NO_STRING     0xFFFFFFFFu
+
+/*!
+ * \brief   Appends a string to a string pool.
+ * \param   strings The pool.
+ * \param   str     The string to append, or NULL.
+ * \return  The offset of the string in the pool, or IMAGE_NO_STRING.
+ */
+static unsigned int appendString(std::vector<char> &strings, const char *str)
+{
+    if (!str)
+        return IMAGE_NO_STRING;
+
+    unsigned int offset = (unsigned int)strings.size();
+    strings.insert(strings.end(), str, str + strlen(str) + 1);
+    return offset;
+}
+
+/*!
+ * \brief   Instantiates an empty image.
+ */
+SymbolImage::SymbolImage()
+    :m_pData(0), m_Size(0), m_pEntries(0), m_pStrings(0)
+{
+}
+
+/*!
+ * \brief   Destroys the image, unmapping its file.
+ */
+SymbolImage::~SymbolImage()
+{
+    unload();
+}
+
+/*!
+ * \brief   Writes a set of symbols to an image file.
+ * \param   symbols The symbols to save, such as SymbolTable::snapshot().
+ * \param   path    The path of the file, which is replaced.
+ * \return  true if the file was written, otherwise false.
+ *
+ * The hash table is kept at most half full, so lookups in the image probe
+ * few entries. The file is in this machine's byte order.
+ */
+bool SymbolImage::save(const SymbolSnapshot &symbols, const char *path)
+{
+    std::vector<const Symbol*> list;
+    symbols.collectSymbols(list);
+
+    unsigned int capacity = IMAGE_MIN_CAPACITY;
+    while (capacity < list.size() * 2)
+        capacity *= 2;
+
+    std::vector<Entry> entries(capacity);
+    for (unsigned int i = 0; i < capacity; i++)
+        entries[i].m_Name = IMAGE_NO_STRING;
+
+    std::vector<char> strings;
+    for (size_t i = 0; i < list.size(); i++)
+    {
+        const Symbol *symbol = list[i];
+        unsigned int slot = symbol->hash() & (capacity - 1);
+        while (entries[slot].m_Name != IMAGE_NO_STRING)
+            slot = (slot + 1) & (capacity - 1);
+
+        Entry &entry = entries[slot];
+        entry.m_Hash = symbol->hash();
+        entry.m_Name = appendString(strings, symbol->name());
+        entry.m_ConstData = appendString(strings, symbol->constData());
+        entry.m_Type = (unsigned char)symbol->type();
+        entry.m_Use = (unsigned char)symbol->use();
+    }
+
+    Header header;
+    header.m_Magic = IMAGE_MAGIC;
+    header.m_Version = IMAGE_VERSION;
+    header.m_Count = (unsigned int)list.size();
+    header.m_Capacity = capacity;
+    header.m_StringsSize = (unsigned int)strings.size();
+    header.m_Size = (unsigned int)(sizeof(Header) + capacity * sizeof(Entry) +
+                                   strings.size());
+
+    FILE *file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    bool written =
+        fwrite(&header, sizeof(Header), 1, file) == 1 &&
+        fwrite(&entries[0], sizeof(Entry), capacity, file) == capacity &&
+        (strings.empty() ||
+         fwrite(&strings[0], 1, strings.size(), file) == strings.size());
+    return fclose(file) == 0 && written;
+}
+
+/*!
+ * \brief   Maps an image file into memory.
+ * \param   path    The path of a file written by save().
+ * \return  true if the file is a valid image, otherwise false, leaving the
+ *          image empty.
+ *
+ * Only the header and the size of each part are checked here, so loading
+ * does not touch the entries. A string offset out of bounds is caught when a
+ * lookup reads it.
+ */
+bool SymbolImage::load(const char *path)
+{
+    unload();
+
+#if defined(_MSC_VER)
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream)
+        return false;
+
+    size_t size = (size_t)stream.tellg();
+    char *data = new char[size ? size : 1];
+    stream.seekg(0);
+    if (!stream.read(data, size))
+    {
+        delete []data;
+        return false;
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    size_t size = (size_t)status.st_size;
+    void *data = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+#endif
+
+    m_pData = static_cast<const char*>(data);
+    m_Size = size;
+
+    if (size < sizeof(Header))
+    {
+        unload();
+        return false;
+    }
+
+    const Header *header = reinterpret_cast<const Header*>(m_pData);
+    size_t tableSize = sizeof(Header) +
+                       (size_t)header->m_Capacity * sizeof(Entry);
+    if (header->m_Magic != IMAGE_MAGIC ||
+        header->m_Version != IMAGE_VERSION ||
+        header->m_Size != size ||
+        header->m_Capacity < IMAGE_MIN_CAPACITY ||
+        (header->m_Capacity & (header->m_Capacity - 1)) ||
+        header->m_Count >= header->m_Capacity ||
+        tableSize + header->m_StringsSize != size ||
+        (header->m_StringsSize && m_pData[size - 1] != '\0'))
+    {
+        unload();
+        return false;
+    }
+
+    m_pEntries = reinterpret_cast<const Entry*>(m_pData + sizeof(Header));
+    m_pStrings = m_pData + tableSize;
+    return true;
+}
+
+/*!
+ * \brief   Gets the number of symbols in the image.
+ * \return  The number of symbols, or 0 if no image is loaded.
+ */
+int SymbolImage::size() const
+{
+    return m_pData ? (int)reinterpret_cast<const Header*>(m_pData)->m_Count : 0;
+}
+
+/*!
+ * \brief   Releases the mapped file.
+ */
+void SymbolImage::unload()
+{
+    if (!m_pData)
+        return;
+
+#if defined(_MSC_VER)
+    delete []m_pData;
+#else
+    munmap(const_cast<char*>(m_pData), m_Size);
+#endif
+    m_pData = 0;
+    m_Size = 0;
+    m_pEntries = 0;
+    m_pStrings = 0;
+}
+
+/*!
+ * \brief   Gets the number of entries in the image's hash table.
+ * \return  The capacity of the table, or 0 if no image is loaded.
+ */
+int SymbolImage::capacity() const
+{
+    return m_pData ? (int)reinterpret_cast<const Header*>(m_pData)->m_Capacity
+                   : 0;
+}
+
+/*!
+ * \brief   Probes the image's hash table for a name.
+ * \param   symbolName  The name to find.
+ * \param   hash        The hash of \p symbolName.
+ * \return  The index of the name's entry, or -1 if the image lacks it.
+ */
+int SymbolImage::findEntry(const char *symbolName, unsigned int hash) const
+{
+    int mask = capacity() - 1;
+    for (int i = hash & mask, probes = 0; probes <= mask;
+         i = (i + 1) & mask, probes++)
+    {
+        const Entry &entry = m_pEntries[i];
+        if (entry.m_Name == IMAGE_NO_STRING)
+            return -1;
+
+        if (entry.m_Hash != hash)
+            continue;
+
+        const char *name = string(entry.m_Name);
+        if (name && !strcmp(name, symbolName))
+            return i;
+    }
+    return -1;
+}
+
+/*!
+ * \brief   Checks whether an entry of the hash table holds a symbol.
+ * \param   index   The index of the entry.
+ * \return  true if the entry holds a symbol with a valid name.
+ */
+bool SymbolImage::isEntryUsed(int index) const
+{
+    return string(m_pEntries[index].m_Name) != 0;
+}
+
+/*!
+ * \brief   Builds a symbol whose strings are those of the image.
+ * \param   index   The index of a used entry.
+ * \return  A new symbol, to be freed with deleteSymbol().
+ *
+ * The symbol's strings point into the mapping and must not be written.
+ */
+Symbol *SymbolImage::newSymbol(int index) const
+{
+    const Entry &entry = m_pEntries[index];
+    return new (::operator new(sizeof(Symbol)))
+        Symbol(const_cast<char*>(string(entry.m_Name)), entry.m_Hash,
+               (E_TYPE)entry.m_Type, (E_USE)entry.m_Use,
+               const_cast<char*>(string(entry.m_ConstData)));
+}
+
+/*!
+ * \brief   Frees a symbol built by newSymbol(). Its strings belong to the
+ *          image, so the symbol is not destroyed.
+ * \param   symbol  The symbol to free.
+ */
+void SymbolImage::deleteSymbol(Symbol *symbol)
+{
+    ::operator delete(symbol);
+}
+
+/*!
+ * \brief   Gets a string from the pool.
+ * \param   offset  The offset of the string.
+ * \return  The string, or NULL if \p offset is IMAGE_NO_STRING or out of
+ *          bounds. The pool ends in a terminator, so any string in it is
+ *          terminated.
+ */
+const char *SymbolImage::string(unsigned int offset) const
+{
+    const Header *header = reinterpret_cast<const Header*>(m_pData);
+    return offset < header->m_StringsSize ? m_pStrings + offset : 0;
+}
@@ -0,0 +1,126 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        symbolimage.h
+ *
+ * \brief       Declares the structure of the SymbolImage class.
+ */
+#ifndef SYMBOLIMAGE_H
+#define SYMBOLIMAGE_H
+
+#include "symbol.h"
+#include <cstddef>
+
+class SymbolSnapshot;
+
+/*!
+ * \brief   The SymbolImage class is a set of symbols saved to a binary file
+ *          and mapped back into memory as is, such as the macros predefined
+ *          for every run of a build.
+ *
+ * The file holds a header, an open-addressing hash table of fixed size entries
+ * and a pool of strings, which the entries refer to by offset. Nothing in it
+ * is a pointer, so it is used where it is mapped without being read, parsed
+ * or copied; only the pages that lookups touch are ever loaded.
+ *
+ * A SymbolTable built on an image finds its symbols as part of the global
+ * scope. The image itself is never written, and must outlive the table.
+ */
+class SymbolImage
+{
+public:
+    /// Creates an empty image.
+    SymbolImage();
+
+    /// Unmaps the image.
+    ~SymbolImage();
+
+    /// Saves the symbols of \p symbols as an image file.
+    static bool save(const SymbolSnapshot &symbols, const char *path);
+
+    /// Maps the image file at \p path, replacing the current image.
+    bool load(const char *path);
+
+    /// Returns the number of symbols in the image.
+    int size() const;
+
+private:
+    friend class SymbolTable;
+
+    /// The start of an image file.
+    struct Header
+    {
+        /// Identifies the file as an image of this version and byte order.
+        unsigned int m_Magic;
+        unsigned int m_Version;
+
+        /// The size of the file, in bytes.
+        unsigned int m_Size;
+
+        /// The number of symbols.
+        unsigned int m_Count;
+
+        /// The number of entries in the hash table, a power of two.
+        unsigned int m_Capacity;
+
+        /// The size of the string pool, which follows the entries.
+        unsigned int m_StringsSize;
+    };
+
+    /// A slot of the image's hash table.
+    struct Entry
+    {
+        /// The hash of the symbol's name.
+        unsigned int m_Hash;
+
+        /// The offsets of the name and constant data in the string pool, or
+        /// IMAGE_NO_STRING for an empty slot or a symbol without data.
+        unsigned int m_Name;
+        unsigned int m_ConstData;
+
+        /// The type and use of the symbol.
+        unsigned char m_Type;
+        unsigned char m_Use;
+    };
+
+    // Images own their mapping and are not copyable
+    SymbolImage(const SymbolImage&);
+    SymbolImage& operator=(const SymbolImage&);
+
+    /// Unmaps the image, leaving it empty.
+    void unload();
+
+    /// Returns the number of entries in the hash table.
+    int capacity() const;
+
+    /// Finds the entry of the symbol named \p symbolName with hash \p hash.
+    int findEntry(const char *symbolName, unsigned int hash) const;
+
+    /// Returns whether entry \p index holds a symbol.
+    bool isEntryUsed(int index) const;
+
+    /// Builds a symbol around the strings of entry \p index.
+    Symbol *newSymbol(int index) const;
+
+    /// Frees a symbol built by newSymbol().
+    static void deleteSymbol(Symbol *symbol);
+
+    /// Returns the string at \p offset of the pool, or NULL if out of bounds.
+    const char *string(unsigned int offset) const;
+
+    /// The mapped file, or NULL when the image is empty.
+    const char *m_pData;
+
+    /// The number of bytes mapped.
+    size_t m_Size;
+
+    /// The hash table within the mapping.
+    const Entry *m_pEntries;
+
+    /// The string pool within the mapping.
+    const char *m_pStrings;
+};
+
+#endif//SYMBOLIMAGE_H
@@ -0,0 +1,538 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        symbolsnapshot.cpp
+ *
+ * \brief       Defines the methods of the SymbolSnapshot class.
+ */
+#include "symbolsnapshot.h"
+#include <string.h>
+#include <new>
+
+/// The number of hash bits which index each level of the trie.
+#define SNAPSHOT_BITS_PER_LEVEL     5
+
+/// Selects the hash bits of one level.
+#define SNAPSHOT_LEVEL_MASK         ((1u << SNAPSHOT_BITS_PER_LEVEL) - 1)
+
+/*!
+ * \brief The E_SNAPSHOT_NODE enum identifies the kind of a trie node.
+ */
+enum E_SNAPSHOT_NODE
+{
+    ESN_BRANCH,
+    ESN_LEAF,
+    ESN_COLLISION
+};
+
+/*!
+ * \brief   The SnapshotNode struct is a node of a snapshot's trie. Its child
+ *          pointers follow it in memory.
+ *
+ * A branch has a child for every bit set in its bitmap, in bit order. A leaf
+ * owns one symbol. A collision node holds the leaves of symbols whose names
+ * have the same full hash.
+ */
+struct SnapshotNode
+{
+    /// The number of parents and snapshots referring to the node.
+    std::atomic<int> m_RefCount;
+
+    /// The kind of node.
+    E_SNAPSHOT_NODE m_Kind;
+
+    /// A branch's bitmap of children, or else the hash of the node's names.
+    unsigned int m_Key;
+
+    /// The number of children.
+    int m_Count;
+
+    /// A leaf's symbol, or NULL.
+    Symbol *m_pSymbol;
+};
+
+/// Returns the array of a node's children.
+static SnapshotNode **nodeChildren(SnapshotNode *node)
+{
+    return reinterpret_cast<SnapshotNode**>(node + 1);
+}
+
+/// Returns the number of bits set in \p bits.
+static int countBits(unsigned int bits)
+{
+    bits = bits - ((bits >> 1) & 0x55555555u);
+    bits = (bits & 0x33333333u) + ((bits >> 2) & 0x33333333u);
+    return (((bits + (bits >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+}
+
+/// Returns the bit which selects \p hash's child of a branch at \p shift.
+static unsigned int branchBit(unsigned int hash, int shift)
+{
+    return 1u << ((hash >> shift) & SNAPSHOT_LEVEL_MASK);
+}
+
+/// Returns the position of the child selected by \p bit in a branch.
+static int branchIndex(const SnapshotNode *branch, unsigned int bit)
+{
+    return countBits(branch->m_Key & (bit - 1));
+}
+
+/*!
+ * \brief   Allocates a node with room for \p count children.
+ * \return  A node with one reference, whose children are not yet set.
+ */
+static SnapshotNode *newNode(E_SNAPSHOT_NODE kind, unsigned int key, int count)
+{
+    SnapshotNode *node = static_cast<SnapshotNode*>(
+        ::operator new(sizeof(SnapshotNode) + count * sizeof(SnapshotNode*)));
+    new (&node->m_RefCount) std::atomic<int>(1);
+    node->m_Kind = kind;
+    node->m_Key = key;
+    node->m_Count = count;
+    node->m_pSymbol = 0;
+    return node;
+}
+
+/// Adds a reference to a node, if there is one.
+static SnapshotNode *retainNode(SnapshotNode *node)
+{
+    if (node)
+        node->m_RefCount.fetch_add(1, std::memory_order_relaxed);
+    return node;
+}
+
+/*!
+ * \brief   Drops a reference to a node, freeing it and releasing its children
+ *          when it was the last.
+ */
+static void releaseNode(SnapshotNode *node)
+{
+    if (!node || node->m_RefCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    SnapshotNode **children = nodeChildren(node);
+    for (int i = 0; i < node->m_Count; i++)
+        releaseNode(children[i]);
+    delete node->m_pSymbol;
+    node->m_RefCount.~atomic<int>();
+    ::operator delete(node);
+}
+
+/*!
+ * \brief   Appends the hash of every leaf under \p node to \p hashes.
+ */
+static void collectNodeHashes(const SnapshotNode *node,
+                              std::vector<unsigned int> &hashes)
+{
+    if (!node)
+        return;
+
+    if (node->m_Kind == ESN_LEAF)
+    {
+        hashes.push_back(node->m_Key);
+        return;
+    }
+
+    SnapshotNode *const *children =
+        reinterpret_cast<SnapshotNode *const*>(node + 1);
+    for (int i = 0; i < node->m_Count; i++)
+        collectNodeHashes(children[i], hashes);
+}
+
+/*!
+ * \brief   Collects the symbols of a subtree.
+ * \param   node    The root of the subtree, or NULL.
+ * \param   symbols The list to append every symbol of the subtree to.
+ */
+static void collectNodeSymbols(const SnapshotNode *node,
+                               std::vector<const Symbol*> &symbols)
+{
+    if (!node)
+        return;
+
+    if (node->m_Kind == ESN_LEAF)
+    {
+        symbols.push_back(node->m_pSymbol);
+        return;
+    }
+
+    SnapshotNode *const *children =
+        reinterpret_cast<SnapshotNode *const*>(node + 1);
+    for (int i = 0; i < node->m_Count; i++)
+        collectNodeSymbols(children[i], symbols);
+}
+
+/*!
+ * \brief   Builds the smallest subtree holding two nodes with different hashes.
+ * \param   a       A leaf or collision node.
+ * \param   b       Another leaf or collision node.
+ * \param   shift   The level of the subtree, in hash bits.
+ * \return  A new branch, which takes a reference to \p a and \p b each.
+ */
+static SnapshotNode *mergeNodes(SnapshotNode *a, SnapshotNode *b, int shift)
+{
+    unsigned int bitA = branchBit(a->m_Key, shift);
+    unsigned int bitB = branchBit(b->m_Key, shift);
+
+    if (bitA == bitB)
+    {
+        SnapshotNode *branch = newNode(ESN_BRANCH, bitA, 1);
+        nodeChildren(branch)[0] =
+            mergeNodes(a, b, shift + SNAPSHOT_BITS_PER_LEVEL);
+        return branch;
+    }
+
+    SnapshotNode *branch = newNode(ESN_BRANCH, bitA | bitB, 2);
+    nodeChildren(branch)[bitA < bitB ? 0 : 1] = retainNode(a);
+    nodeChildren(branch)[bitA < bitB ? 1 : 0] = retainNode(b);
+    return branch;
+}
+
+/*!
+ * \brief   Builds a copy of \p node with \p leaf added, replacing any leaf of
+ *          the same name.
+ * \param   node        The subtree, or NULL.
+ * \param   shift       The level of the subtree, in hash bits.
+ * \param   leaf        The leaf to add.
+ * \param   replaced    Set to true if a leaf was replaced.
+ * \return  The new subtree, with one reference. Unchanged children are shared.
+ */
+static SnapshotNode *insertNode(SnapshotNode *node, int shift,
+                                SnapshotNode *leaf, bool *replaced)
+{
+    if (!node)
+        return retainNode(leaf);
+
+    unsigned int hash = leaf->m_Key;
+    const char *name = leaf->m_pSymbol->name();
+
+    if (node->m_Kind == ESN_BRANCH)
+    {
+        unsigned int bit = branchBit(hash, shift);
+        int index = branchIndex(node, bit);
+        bool present = (node->m_Key & bit) != 0;
+        int count = node->m_Count + (present ? 0 : 1);
+
+        SnapshotNode *branch = newNode(ESN_BRANCH, node->m_Key | bit, count);
+        SnapshotNode **from = nodeChildren(node), **to = nodeChildren(branch);
+        for (int i = 0, j = 0; i < count; i++)
+        {
+            if (i == index)
+            {
+                to[i] = present ? insertNode(from[j++], shift +
+                                             SNAPSHOT_BITS_PER_LEVEL,
+                                             leaf, replaced)
+                                : retainNode(leaf);
+            }
+            else
+                to[i] = retainNode(from[j++]);
+        }
+        return branch;
+    }
+
+    if (node->m_Key != hash)
+        return mergeNodes(node, leaf, shift);
+
+    if (node->m_Kind == ESN_LEAF)
+    {
+        if (!strcmp(node->m_pSymbol->name(), name))
+        {
+            *replaced = true;
+            return retainNode(leaf);
+        }
+
+        SnapshotNode *collision = newNode(ESN_COLLISION, hash, 2);
+        nodeChildren(collision)[0] = retainNode(node);
+        nodeChildren(collision)[1] = retainNode(leaf);
+        return collision;
+    }
+
+    // A collision node of the same hash; replace the name or append it
+    SnapshotNode **from = nodeChildren(node);
+    int index = node->m_Count;
+    for (int i = 0; i < node->m_Count; i++)
+        if (!strcmp(from[i]->m_pSymbol->name(), name))
+            index = i;
+
+    *replaced = index < node->m_Count;
+    int count = node->m_Count + (*replaced ? 0 : 1);
+    SnapshotNode *collision = newNode(ESN_COLLISION, hash, count);
+    SnapshotNode **to = nodeChildren(collision);
+    for (int i = 0; i < count; i++)
+        to[i] = retainNode(i == index ? leaf : from[i]);
+    return collision;
+}
+
+/*!
+ * \brief   Builds a copy of \p node without the leaf named \p name.
+ * \param   node        The subtree, or NULL.
+ * \param   shift       The level of the subtree, in hash bits.
+ * \param   hash        The hash of \p name.
+ * \param   name        The name of the leaf to remove.
+ * \param   removed     Set to true if a leaf was removed.
+ * \return  The new subtree with one reference, or NULL if it is empty.
+ *
+ * A branch left with a single leaf or collision node is replaced by that node,
+ * so the trie stays as shallow as its contents allow.
+ */
+static SnapshotNode *removeNode(SnapshotNode *node, int shift,
+                                unsigned int hash, const char *name,
+                                bool *removed)
+{
+    if (!node)
+        return 0;
+
+    if (node->m_Kind == ESN_LEAF)
+    {
+        if (node->m_Key == hash && !strcmp(node->m_pSymbol->name(), name))
+        {
+            *removed = true;
+            return 0;
+        }
+        return retainNode(node);
+    }
+
+    SnapshotNode **from = nodeChildren(node);
+
+    if (node->m_Kind == ESN_COLLISION)
+    {
+        int index = -1;
+        for (int i = 0; node->m_Key == hash && i < node->m_Count; i++)
+            if (!strcmp(from[i]->m_pSymbol->name(), name))
+                index = i;
+
+        if (index < 0)
+            return retainNode(node);
+
+        *removed = true;
+        if (node->m_Count == 2)
+            return retainNode(from[1 - index]);
+
+        SnapshotNode *collision = newNode(ESN_COLLISION, hash, node->m_Count - 1);
+        for (int i = 0, j = 0; i < node->m_Count; i++)
+            if (i != index)
+                nodeChildren(collision)[j++] = retainNode(from[i]);
+        return collision;
+    }
+
+    unsigned int bit = branchBit(hash, shift);
+    if (!(node->m_Key & bit))
+        return retainNode(node);
+
+    int index = branchIndex(node, bit);
+    SnapshotNode *child = removeNode(from[index],
+                                     shift + SNAPSHOT_BITS_PER_LEVEL,
+                                     hash, name, removed);
+    if (!*removed)
+    {
+        releaseNode(child);
+        return retainNode(node);
+    }
+
+    if (!child)
+    {
+        if (node->m_Count == 1)
+            return 0;
+        if (node->m_Count == 2 && from[1 - index]->m_Kind != ESN_BRANCH)
+            return retainNode(from[1 - index]);
+
+        SnapshotNode *branch = newNode(ESN_BRANCH, node->m_Key & ~bit,
+                                       node->m_Count - 1);
+        for (int i = 0, j = 0; i < node->m_Count; i++)
+            if (i != index)
+                nodeChildren(branch)[j++] = retainNode(from[i]);
+        return branch;
+    }
+
+    if (node->m_Count == 1 && child->m_Kind != ESN_BRANCH)
+        return child;
+
+    SnapshotNode *branch = newNode(ESN_BRANCH, node->m_Key, node->m_Count);
+    for (int i = 0; i < node->m_Count; i++)
+        nodeChildren(branch)[i] = i == index ? child : retainNode(from[i]);
+    return branch;
+}
+
+
+
+/*!
+ * \brief   Instantiates an empty snapshot.
+ */
+SymbolSnapshot::SymbolSnapshot()
+    :m_pRoot(0), m_Size(0)
+{
+}
+
+/*!
+ * \brief   Instantiates a copy of \p snapshot in constant time.
+ * \param   snapshot    The snapshot to copy.
+ */
+SymbolSnapshot::SymbolSnapshot(const SymbolSnapshot &snapshot)
+    :m_pRoot(retainNode(snapshot.m_pRoot.load(std::memory_order_acquire))),
+     m_Size(snapshot.m_Size)
+{
+}
+
+/*!
+ * \brief   Destroys the snapshot. Nodes shared with other snapshots survive.
+ */
+SymbolSnapshot::~SymbolSnapshot()
+{
+    releaseNode(m_pRoot.load(std::memory_order_relaxed));
+}
+
+/*!
+ * \brief   Makes this snapshot a copy of \p snapshot in constant time.
+ * \param   snapshot    The snapshot to copy.
+ * \return  This snapshot.
+ */
+SymbolSnapshot& SymbolSnapshot::operator=(const SymbolSnapshot &snapshot)
+{
+    setRoot(retainNode(snapshot.m_pRoot.load(std::memory_order_acquire)));
+    m_Size = snapshot.m_Size;
+    return *this;
+}
+
+/*!
+ * \brief   Adds a symbol to the snapshot.
+ * \param   name    The name of the new symbol.
+ * \param   type    The type of the new symbol.
+ * \param   use     The purpose of the new symbol.
+ * \param   data    The constant data for the new symbol.
+ * \return  true if the symbol was added, or false if the name was taken.
+ */
+bool SymbolSnapshot::addSymbol(const char *name, E_TYPE type, E_USE use,
+                               const char *data)
+{
+    if (findSymbol(name, hashSymbolName(name)))
+        return false;
+
+    setSymbol(name, type, use, data);
+    return true;
+}
+
+/*!
+ * \brief   Removes a symbol from the snapshot, copying the path to it.
+ * \param   symbolName  The name of the symbol to be removed.
+ */
+void SymbolSnapshot::removeSymbol(const char *symbolName)
+{
+    bool removed = false;
+    SnapshotNode *root = removeNode(m_pRoot.load(std::memory_order_relaxed), 0,
+                                    hashSymbolName(symbolName), symbolName,
+                                    &removed);
+    setRoot(root);
+    if (removed)
+        m_Size--;
+}
+
+/*!
+ * \brief   Finds a symbol whose name matches \p symbolName.
+ * \param   symbolName  The name of the symbol to search for.
+ * \return  A wrapper to the matching symbol, or a wrapper around NULL.
+ */
+SymbolPtr SymbolSnapshot::findSymbol(const char *symbolName) const
+{
+    return SymbolPtr(findSymbol(symbolName, hashSymbolName(symbolName)));
+}
+
+/*!
+ * \brief   Gets the number of symbols in the snapshot.
+ * \return  The number of symbols.
+ */
+int SymbolSnapshot::size() const
+{
+    return m_Size;
+}
+
+/*!
+ * \brief   Adds a symbol to the snapshot, replacing any of the same name.
+ * \param   name    The name of the symbol.
+ * \param   type    The type of the symbol.
+ * \param   use     The purpose of the symbol.
+ * \param   data    The constant data for the symbol.
+ */
+void SymbolSnapshot::setSymbol(const char *name, E_TYPE type, E_USE use,
+                               const char *data)
+{
+    SnapshotNode *leaf = newNode(ESN_LEAF, hashSymbolName(name), 0);
+    leaf->m_pSymbol = new Symbol(name, type, use, data);
+
+    bool replaced = false;
+    SnapshotNode *root = insertNode(m_pRoot.load(std::memory_order_relaxed), 0,
+                                    leaf, &replaced);
+    releaseNode(leaf);
+    setRoot(root);
+    if (!replaced)
+        m_Size++;
+}
+
+/*!
+ * \brief   Walks the trie to the symbol named \p symbolName.
+ * \param   symbolName  The name of the symbol to search for.
+ * \param   hash        The hash of \p symbolName.
+ * \return  Pointer to the matching symbol, or NULL.
+ */
+Symbol* SymbolSnapshot::findSymbol(const char *symbolName,
+                                   unsigned int hash) const
+{
+    SnapshotNode *node = m_pRoot.load(std::memory_order_acquire);
+
+    for (int shift = 0; node; shift += SNAPSHOT_BITS_PER_LEVEL)
+    {
+        if (node->m_Kind == ESN_BRANCH)
+        {
+            unsigned int bit = branchBit(hash, shift);
+            if (!(node->m_Key & bit))
+                return 0;
+            node = nodeChildren(node)[branchIndex(node, bit)];
+            continue;
+        }
+
+        if (node->m_Key != hash)
+            return 0;
+
+        if (node->m_Kind == ESN_LEAF)
+            return strcmp(node->m_pSymbol->name(), symbolName) ? 0
+                                                               : node->m_pSymbol;
+
+        for (int i = 0; i < node->m_Count; i++)
+        {
+            Symbol *symbol = nodeChildren(node)[i]->m_pSymbol;
+            if (!strcmp(symbol->name(), symbolName))
+                return symbol;
+        }
+        return 0;
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief   Collects the name hashes of the snapshot.
+ * \param   hashes  The list to append every symbol's hash to.
+ */
+void SymbolSnapshot::collectHashes(std::vector<unsigned int> &hashes) const
+{
+    collectNodeHashes(m_pRoot.load(std::memory_order_acquire), hashes);
+}
+
+/*!
+ * \brief   Collects the symbols of the snapshot.
+ * \param   symbols The list to append every symbol to.
+ */
+void SymbolSnapshot::collectSymbols(std::vector<const Symbol*> &symbols) const
+{
+    collectNodeSymbols(m_pRoot.load(std::memory_order_acquire), symbols);
+}
+
+/*!
+ * \brief   Publishes a new root, then releases the old one.
+ * \param   root    The new root, whose reference the snapshot takes over.
+ */
+void SymbolSnapshot::setRoot(SnapshotNode *root)
+{
+    releaseNode(m_pRoot.exchange(root, std::memory_order_acq_rel));
+}
@@ -0,0 +1,82 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        symbolsnapshot.h
+ *
+ * \brief       Declares the structure of the SymbolSnapshot class.
+ */
+#ifndef SYMBOLSNAPSHOT_H
+#define SYMBOLSNAPSHOT_H
+
+#include "symbol.h"
+#include <atomic>
+#include <vector>
+
+struct SnapshotNode;
+
+/*!
+ * \brief   The SymbolSnapshot class is a set of symbols which can be copied in
+ *          constant time, such as the predefined state every translation unit
+ *          starts from.
+ *
+ * The symbols are kept in a persistent hash trie: a tree of nodes indexed by
+ * five bits of the name hash per level. Nodes are reference counted and never
+ * changed once built, so copies share them. Adding or removing a symbol copies
+ * only the nodes on the path to it, leaving every other copy untouched.
+ */
+class SymbolSnapshot
+{
+public:
+    /// Creates an empty snapshot.
+    SymbolSnapshot();
+
+    /// Creates a copy of \p snapshot, sharing all of its nodes.
+    SymbolSnapshot(const SymbolSnapshot &snapshot);
+
+    /// Releases the snapshot's nodes.
+    ~SymbolSnapshot();
+
+    /// Makes this a copy of \p snapshot, sharing all of its nodes.
+    SymbolSnapshot& operator=(const SymbolSnapshot &snapshot);
+
+    /// Adds a symbol, unless one by that name is already in the snapshot.
+    bool addSymbol(const char *name, E_TYPE type, E_USE use, const char *data);
+
+    /// Removes a symbol from the snapshot.
+    void removeSymbol(const char *symbolName);
+
+    /// Finds a symbol in the snapshot and returns it.
+    SymbolPtr findSymbol(const char *symbolName) const;
+
+    /// Returns the number of symbols in the snapshot.
+    int size() const;
+
+private:
+    friend class SymbolTable;
+    friend class SymbolImage;
+
+    /// Adds a symbol, replacing any symbol by that name.
+    void setSymbol(const char *name, E_TYPE type, E_USE use, const char *data);
+
+    /// Finds the symbol named \p symbolName with hash \p hash.
+    Symbol *findSymbol(const char *symbolName, unsigned int hash) const;
+
+    /// Appends the hash of every symbol's name to \p hashes.
+    void collectHashes(std::vector<unsigned int> &hashes) const;
+
+    /// Appends every symbol of the snapshot to \p symbols.
+    void collectSymbols(std::vector<const Symbol*> &symbols) const;
+
+    /// Makes \p root the root node, releasing the old root.
+    void setRoot(SnapshotNode *root);
+
+    /// The root of the trie, or NULL when the snapshot is empty.
+    std::atomic<SnapshotNode*> m_pRoot;
+
+    /// The number of symbols in the snapshot.
+    int m_Size;
+};
+
+#endif//SYMBOLSNAPSHOT_H
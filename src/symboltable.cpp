@@ -8,7 +8,28 @@
  * \brief       Defines the methods of the SymbolTable class.
  */
 #include "symboltable.h"
+#include "epochreclaimer.h"
 #include <string.h>
+#include <new>
+
+/// The number of names findSymbols() hashes and prefetches at a time.
+#define FIND_BATCH_SIZE         16
+
+/// Marks an image symbol removed from the table.
+static char s_RemovedImageSymbol;
+#define REMOVED_IMAGE_SYMBOL    reinterpret_cast<Symbol*>(&s_RemovedImageSymbol)
+
+/// The number of slots in the name table's first hash table.
+#define FIRST_NAME_CAPACITY     16
+
+/// The key of a slot which never held a name, where probing stops.
+#define EMPTY_KEY       0u
+
+/// The key of a slot whose name was unbound, so probing continues past it.
+#define TOMBSTONE_KEY   1u
+
+/// The smallest key of a slot holding a name.
+#define FIRST_NAME_KEY  2u
 
 /*!
  * \brief   Instantiates a new SymbolTable object.
@@ -16,24 +37,63 @@
  * Creates a symbol table with an initial, global scope to contain symbols.
  */
 SymbolTable::SymbolTable()
-    :m_pHeadScope(0), m_Scope(0)
+    :m_pHeadScope(0), m_Scope(0), m_pImage(0), m_pImageSymbols(0),
+     m_Concurrent(false), m_pStats(0)
 {
     pushScope();
 }
 
 /*!
- * \brief   Destroys a symbol table, taking allocated memory with it.
+ * \brief   Instantiates a new SymbolTable object on top of a snapshot.
+ * \param   base    The symbols the global scope starts with.
+ *
+ * Taking the snapshot is constant time. Its symbols are found as if they were
+ * declared in the global scope; removing one only changes this table's copy.
  */
-SymbolTable::~SymbolTable()
+SymbolTable::SymbolTable(const SymbolSnapshot &base)
+    :m_pHeadScope(0), m_Scope(0), m_Base(base), m_pImage(0),
+     m_pImageSymbols(0), m_Concurrent(false), m_pStats(0)
 {
-    SymbolTableScope *scope = m_pHeadScope, *nextScope = 0;
+    if (m_Base.size())
+        rebuildFilter();
+    pushScope();
+}
+
+/*!
+ * \brief   Instantiates a new SymbolTable object on top of a symbol image.
+ * \param   image   The symbols the global scope starts with, which must
+ *                  outlive the table.
+ *
+ * Nothing is read from the image but the name hashes for the filter. Its
+ * symbols are found as if they were declared in the global scope; removing
+ * one only hides it from this table.
+ */
+SymbolTable::SymbolTable(const SymbolImage &image)
+    :m_pHeadScope(0), m_Scope(0), m_pImage(&image), m_pImageSymbols(0),
+     m_Concurrent(false), m_pStats(0)
+{
+    if (image.size())
+    {
+        m_pImageSymbols = new std::atomic<Symbol*>[image.capacity()]();
+        rebuildFilter();
+    }
+    pushScope();
+}
 
-    while (scope)
+/*!
+ * \brief   Destroys a symbol table. The arena takes every scope and symbol
+ *          with it; the symbols built from the image are freed here.
+ */
+SymbolTable::~SymbolTable()
+{
+    for (int i = 0; m_pImageSymbols && i < m_pImage->capacity(); i++)
     {
-        nextScope = scope->m_pNextScope;
-        delete scope;
-        scope = nextScope;
+        Symbol *symbol = m_pImageSymbols[i].load(std::memory_order_relaxed);
+        if (symbol && symbol != REMOVED_IMAGE_SYMBOL)
+            SymbolImage::deleteSymbol(symbol);
     }
+    delete []m_pImageSymbols;
+    delete m_pStats;
 }
 
 /*!
@@ -42,21 +102,48 @@ SymbolTable::~SymbolTable()
  */
 int SymbolTable::pushScope()
 {
+    std::unique_lock<std::mutex> lock = lockWriters();
+    SymbolArena::Mark mark = m_Arena.mark();
     SymbolTableScope *oldHead = m_pHeadScope;
-    m_pHeadScope = new SymbolTableScope;
+    m_pHeadScope = new (m_Arena.allocate(sizeof(SymbolTableScope)))
+        SymbolTableScope(mark);
     m_pHeadScope->m_pNextScope = oldHead;
-    return ++m_Scope;
+
+    int scope = ++m_Scope;
+    if (m_pStats)
+        m_pStats->recordPush(scope);
+    return scope;
 }
 
 /*!
  * \brief   Pops the local-most scope from the symbol table.
+ *
+ * Each symbol declared in the scope is unbound from the name table, restoring
+ * the symbol it shadowed. The scope and its symbols are then released at once
+ * by rewinding the arena. In concurrent mode the rewind waits until no reader
+ * can still hold one of the symbols.
  */
 void SymbolTable::popScope()
 {
+    std::unique_lock<std::mutex> lock = lockWriters();
     SymbolTableScope *oldHead = m_pHeadScope;
+
+    for (Symbol *symbol = oldHead->headSymbol(); symbol;
+         symbol = symbol->nextSymbol())
+    {
+        m_Names.unbind(symbol);
+        if (!symbol->shadowedSymbol())
+            m_Filter.remove(symbol->hash());
+    }
+
     m_pHeadScope = m_pHeadScope->m_pNextScope;
-    delete oldHead;
+    if (m_Concurrent)
+        EpochReclaimer::synchronize();
+    m_Arena.rewind(oldHead->m_Mark);
     m_Scope--;
+
+    if (m_pStats)
+        m_pStats->recordPop();
 }
 
 /*!
@@ -75,157 +162,907 @@ int SymbolTable::scope()
  * \param   use     The purpose of the new symbol.
  * \param   data    The constant data for the new symbol.
  * \return  true if symbol was added, otherwise false.
+ *
+ * The innermost symbol of the same name, if any, is only a conflict when it
+ * was declared in the current scope. Otherwise the new symbol shadows it.
  */
 bool SymbolTable::addSymbol(const char *name, E_TYPE type, E_USE use,
                             const char *data)
 {
-    return m_pHeadScope->addSymbol(name, type, use, data);
+    std::unique_lock<std::mutex> lock = lockWriters();
+    bool added = addSymbolLocked(name, hashSymbolName(name), type, use, data);
+
+    if (m_pStats)
+        m_pStats->recordAdd(added);
+    return added;
+}
+
+/*!
+ * \brief   Adds a symbol to the current scope, with writers locked out.
+ * \param   name    The name of the new symbol.
+ * \param   hash    The hash of \p name.
+ * \param   type    The type of the new symbol.
+ * \param   use     The purpose of the new symbol.
+ * \param   data    The constant data for the new symbol.
+ * \return  true if symbol was added, otherwise false.
+ */
+bool SymbolTable::addSymbolLocked(const char *name, unsigned int hash,
+                                  E_TYPE type, E_USE use, const char *data)
+{
+    Symbol *shadowed;
+    if (!canDeclare(name, hash, &shadowed))
+        return false;
+
+    // The symbol and its strings share one block, which the global scope
+    // recycles from the symbols removed from it
+    size_t nameLength = strlen(name) + 1;
+    size_t dataLength = data ? strlen(data) + 1 : 0;
+    size_t size = sizeof(Symbol) + nameLength + dataLength;
+    char *block = static_cast<char*>(m_Scope == 1 ? m_Arena.reuse(size)
+                                                  : m_Arena.allocate(size));
+
+    char *symbolName = block + sizeof(Symbol);
+    memcpy(symbolName, name, nameLength);
+    char *symbolData = 0;
+    if (data)
+    {
+        symbolData = symbolName + nameLength;
+        memcpy(symbolData, data, dataLength);
+    }
+
+    declareSymbol(new (block) Symbol(symbolName, hash, type, use, symbolData),
+                  shadowed);
+
+    if (m_Filter.isCrowded())
+        rebuildFilter();
+
+    return true;
+}
+
+/*!
+ * \brief   Adds a batch of symbols to the symbol table's current scope.
+ * \param   symbols The symbols to add, such as LLC_KEYWORDS.
+ * \param   count   The number of symbols in \p symbols.
+ * \return  The number of symbols added. A symbol whose name is taken in the
+ *          current scope, including by an earlier one of the batch, is skipped.
+ *
+ * The batch costs one lock, one growth of the name table and one arena
+ * allocation holding every symbol and string, however many symbols it holds.
+ * Each name is checked and bound in a single pass, and the filter is rebuilt
+ * at most once, after the last.
+ */
+int SymbolTable::addSymbols(const SymbolDefinition *symbols, int count)
+{
+    std::unique_lock<std::mutex> lock = lockWriters();
+    if (!m_pHeadScope || count <= 0)
+        return 0;
+
+    // The symbols come first in the block, so they are aligned; their strings
+    // are packed after them
+    size_t size = count * sizeof(Symbol);
+    for (int i = 0; i < count; i++)
+    {
+        size += strlen(symbols[i].m_pName) + 1;
+        if (symbols[i].m_pConstData)
+            size += strlen(symbols[i].m_pConstData) + 1;
+    }
+
+    char *block = static_cast<char*>(m_Arena.allocate(size));
+    Symbol *nextSymbol = reinterpret_cast<Symbol*>(block);
+    char *nextString = block + count * sizeof(Symbol);
+
+    m_Names.reserve(count);
+
+    int added = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const SymbolDefinition &definition = symbols[i];
+        unsigned int hash = hashSymbolName(definition.m_pName);
+        Symbol *shadowed;
+        bool declarable = canDeclare(definition.m_pName, hash, &shadowed);
+        if (m_pStats)
+            m_pStats->recordAdd(declarable);
+        if (!declarable)
+            continue;
+
+        char *name = nextString;
+        size_t length = strlen(definition.m_pName) + 1;
+        memcpy(name, definition.m_pName, length);
+        nextString += length;
+
+        char *data = 0;
+        if (definition.m_pConstData)
+        {
+            data = nextString;
+            length = strlen(definition.m_pConstData) + 1;
+            memcpy(data, definition.m_pConstData, length);
+            nextString += length;
+        }
+
+        declareSymbol(new (nextSymbol++) Symbol(name, hash, definition.m_Type,
+                                                definition.m_Use, data),
+                      shadowed);
+        added++;
+    }
+
+    if (m_Filter.isCrowded())
+        rebuildFilter();
+
+    return added;
+}
+
+/*!
+ * \brief   Checks whether a name may be declared in the current scope.
+ * \param   name        The name to declare.
+ * \param   hash        The hash of \p name.
+ * \param   shadowed    Receives the innermost symbol of the name, or NULL.
+ * \return  true if no symbol of the current scope has the name. At the global
+ *          scope that includes the symbols of the base snapshot.
+ */
+bool SymbolTable::canDeclare(const char *name, unsigned int hash,
+                             Symbol **shadowed)
+{
+    *shadowed = 0;
+    if (!m_pHeadScope)
+        return false;
+
+    *shadowed = m_Names.find(name, hash);
+    if (*shadowed && (*shadowed)->scope() == m_Scope)
+        return false;
+
+    // The base snapshot and image belong to the global scope
+    if (!*shadowed && m_Scope == 1 &&
+        (m_Base.findSymbol(name, hash) || findImageEntry(name, hash) >= 0))
+        return false;
+
+    return true;
+}
+
+/*!
+ * \brief   Binds a new symbol and lists it in the current scope.
+ * \param   symbol      The new symbol, whose name canDeclare() allowed.
+ * \param   shadowed    The symbol canDeclare() found, or NULL.
+ */
+void SymbolTable::declareSymbol(Symbol *symbol, Symbol *shadowed)
+{
+    // A name bound for the first time is counted into the filter
+    if (!shadowed)
+        m_Filter.add(symbol->hash());
+
+    symbol->setScope(m_Scope);
+    symbol->setShadowedSymbol(shadowed);
+    m_Names.bind(symbol);
+    m_pHeadScope->linkSymbol(symbol);
 }
 
 /*!
  * \brief   Removes a symbol from the symbol table.
  * \param   symbolName  The name of the symbol to be removed.
+ *
+ * The innermost symbol of the name is removed, uncovering any symbol it
+ * shadowed. A symbol of the global scope, which is never popped, gives its
+ * block back to the arena for the next symbol added there; in concurrent mode
+ * once no reader can still hold it. The memory of any other symbol stays in
+ * the arena until its scope is popped.
+ *
+ * A symbol of the base snapshot is removed from the table's copy by copying
+ * the path to it. In concurrent mode the old path is kept until no reader can
+ * still be walking it.
  */
 void SymbolTable::removeSymbol(const char *symbolName)
 {
-    SymbolTableScope *scope = m_pHeadScope;
+    std::unique_lock<std::mutex> lock = lockWriters();
+    unsigned int hash = hashSymbolName(symbolName);
+    Symbol *symbol = m_Names.find(symbolName, hash);
 
-    // Iterate through the list of scopes until exhausted
-    while (scope)
+    // If no scope declares the symbol, it may be in the base snapshot or image
+    if (!symbol)
     {
-        if (scope->removeSymbol(symbolName))
-            break;
+        int entry = findImageEntry(symbolName, hash);
+        if (entry >= 0)
+        {
+            if (m_pStats)
+                m_pStats->recordRemove();
+
+            Symbol *built = m_pImageSymbols[entry].exchange(
+                REMOVED_IMAGE_SYMBOL, std::memory_order_acq_rel);
+            m_Filter.remove(hash);
+            if (built)
+            {
+                if (m_Concurrent)
+                    EpochReclaimer::synchronize();
+                SymbolImage::deleteSymbol(built);
+            }
+            return;
+        }
+
+        if (!m_Base.findSymbol(symbolName, hash))
+            return;
+
+        if (m_pStats)
+            m_pStats->recordRemove();
+
+        SymbolSnapshot oldBase(m_Base);
+        m_Base.removeSymbol(symbolName);
+        m_Filter.remove(hash);
+        if (m_Concurrent)
+            EpochReclaimer::synchronize();
+        return;
+    }
+
+    if (m_pStats)
+        m_pStats->recordRemove();
+
+    // Walk out to the scope the symbol was declared in
+    SymbolTableScope *scope = m_pHeadScope;
+    for (int depth = m_Scope; depth > symbol->scope(); depth--)
         scope = scope->m_pNextScope;
+
+    m_Names.unbind(symbol);
+    if (!symbol->shadowedSymbol())
+        m_Filter.remove(hash);
+    scope->unlinkSymbol(symbol);
+
+    // Only a symbol whose strings follow it owns its block; those added in a
+    // batch share theirs
+    char *name = symbol->name();
+    if (symbol->scope() == 1 && name == reinterpret_cast<char*>(symbol + 1))
+    {
+        size_t size = sizeof(Symbol) + strlen(name) + 1;
+        if (symbol->constData())
+            size += strlen(symbol->constData()) + 1;
+
+        if (m_Concurrent)
+            EpochReclaimer::synchronize();
+        m_Arena.release(symbol, size);
     }
 }
 
+/*!
+ * \brief   Gets the memory the table's scopes, symbols and strings take.
+ * \return  The number of bytes handed out by the table's arena.
+ */
+size_t SymbolTable::memoryUsage() const
+{
+    std::unique_lock<std::mutex> lock = lockWriters();
+    return m_Arena.size();
+}
+
 /*!
  * \brief   Finds a symbol who name matches /p symbolName.
  * \param   symbolName The name of the symbol to search for.
  * \return  A wrapper to the symbol whose name matches /p symbolName, or a
  *          wrapper around NULL, if no match is found.
  *
- * findSymbol performs string comparisons against entries in the symbol table at
- * the current scope. If no matching symbol is found in the current scope, the
- * next scope is searched. This continues until all scopes are exhausted. Due to
- * this search algorithm, a matching symbol from the most local scope is always
- * returned.
+ * findSymbol hashes \p symbolName once and probes the name table, which always
+ * holds the symbol of the most local scope declaring the name. The cost does
+ * not depend on how many scopes are open. Names the table does not bind are
+ * then looked up in the base snapshot.
+ *
+ * Most lookups miss, so both are skipped when the Bloom filter over every
+ * name in the table and base rules the name out.
  *
  * If no symbol in any scope matches /p symbolName, the function returns a
  * wrapper around NULL.
+ *
+ * In concurrent mode the lookup runs in a read section and never waits on a
+ * writer. A symbol found in a scope which another thread may pop is only safe
+ * to use while the caller holds its own EpochReclaimer::ReadSection, as is a
+ * base symbol which another thread may remove. Symbols added to the global
+ * scope live until they are removed, or the table is destroyed.
  */
 SymbolPtr SymbolTable::findSymbol(const char *symbolName) const
 {
-    SymbolTableScope *scope = m_pHeadScope;
-    SymbolPtr symbol(0);
+    unsigned int hash = hashSymbolName(symbolName);
 
-    while (scope && symbol.isNull())
+    if (m_Concurrent)
     {
-        symbol = scope->findSymbol(symbolName);
-        scope = scope->m_pNextScope;
+        EpochReclaimer::ReadSection section;
+        return SymbolPtr(findSymbolInternal(symbolName, hash));
     }
 
+    return SymbolPtr(findSymbolInternal(symbolName, hash));
+}
+
+/*!
+ * \brief   Looks a name up in the filter, the name table, the base, then the
+ *          image.
+ * \param   symbolName  The name of the symbol to search for.
+ * \param   hash        The hash of \p symbolName.
+ * \return  Pointer to the innermost matching symbol, or NULL.
+ */
+Symbol* SymbolTable::findSymbolInternal(const char *symbolName,
+                                        unsigned int hash) const
+{
+    if (!m_Filter.mayContain(hash))
+    {
+        if (m_pStats)
+            m_pStats->recordFind(m_Scope, false, true, 0);
+        return 0;
+    }
+
+    int probes = 0;
+    Symbol *symbol = m_Names.find(symbolName, hash, &probes);
+    if (!symbol)
+        symbol = m_Base.findSymbol(symbolName, hash);
+    if (!symbol && m_pImageSymbols)
+        symbol = findImageSymbol(symbolName, hash);
+
+    if (m_pStats)
+        m_pStats->recordFind(m_Scope, symbol != 0, false, probes);
     return symbol;
 }
 
+/*!
+ * \brief   Finds the symbols of a batch of names.
+ * \param   symbolNames The names of the symbols to search for.
+ * \param   count       The number of names in \p symbolNames.
+ * \param   symbols     Receives a wrapper for each name, in order, around its
+ *                      innermost symbol or NULL, as findSymbol() would return.
+ *
+ * A single lookup stalls on each cache miss in turn: the filter, the name
+ * table slot, then the symbol. Here the names are taken a batch at a time and
+ * every miss of a stage is started before any result of it is needed, so the
+ * misses of a batch overlap.
+ *
+ * In concurrent mode the whole batch shares one read section.
+ */
+void SymbolTable::findSymbols(const char *const *symbolNames, int count,
+                              std::vector<SymbolPtr> &symbols) const
+{
+    symbols.reserve(symbols.size() + count);
 
+    if (m_Concurrent)
+    {
+        EpochReclaimer::ReadSection section;
+        findSymbolsInternal(symbolNames, count, symbols);
+        return;
+    }
+
+    findSymbolsInternal(symbolNames, count, symbols);
+}
 
 /*!
- * \brief   Instantiates a new SymbolTableScope object.
+ * \brief   Finds the symbols of a batch of names in stages.
+ * \param   symbolNames The names of the symbols to search for.
+ * \param   count       The number of names in \p symbolNames.
+ * \param   symbols     Receives a wrapper for each name, in order.
  */
-SymbolTable::SymbolTableScope::SymbolTableScope()
-    :m_pNextScope(0), m_pHeadSymbol(0)
+void SymbolTable::findSymbolsInternal(const char *const *symbolNames,
+                                      int count,
+                                      std::vector<SymbolPtr> &symbols) const
 {
+    unsigned int hashes[FIND_BATCH_SIZE];
+
+    for (int first = 0; first < count; first += FIND_BATCH_SIZE)
+    {
+        const char *const *names = symbolNames + first;
+        int size = count - first < FIND_BATCH_SIZE ? count - first
+                                                   : FIND_BATCH_SIZE;
+
+        // Hash the names and start loading their filter counters
+        for (int i = 0; i < size; i++)
+        {
+            hashes[i] = hashSymbolName(names[i]);
+            m_Filter.prefetch(hashes[i]);
+        }
+
+        // Start loading the slots of the names the filter lets through
+        for (int i = 0; i < size; i++)
+        {
+            if (m_Filter.mayContain(hashes[i]))
+                m_Names.prefetch(hashes[i]);
+        }
+
+        for (int i = 0; i < size; i++)
+            symbols.push_back(SymbolPtr(findSymbolInternal(names[i],
+                                                           hashes[i])));
+    }
+}
+
+/*!
+ * \brief   Turns concurrent mode on or off.
+ * \param   concurrent  Whether threads will read the table while it is written.
+ *
+ * The mode must be set before the table is shared between threads.
+ */
+void SymbolTable::setConcurrent(bool concurrent)
+{
+    m_Concurrent = concurrent;
+    m_Names.m_Concurrent = concurrent;
 }
 
 /*!
- * \brief Deletes a symbol table scope, taking allocated memory with it.
+ * \brief   Turns the collection of statistics on or off.
+ * \param   enabled     Whether to count the table's operations.
+ *
+ * Enabling starts from zeroed counters; disabling discards them. Like the
+ * concurrent mode, this must be set before the table is shared. Without
+ * statistics, each operation pays one untaken branch.
  */
-SymbolTable::SymbolTableScope::~SymbolTableScope()
+void SymbolTable::setStatsEnabled(bool enabled)
 {
-    Symbol *symbol = m_pHeadSymbol, *nextSymbol = 0;
+    if (enabled == (m_pStats != 0))
+        return;
 
-    while (symbol)
+    if (enabled)
+    {
+        m_pStats = new SymbolTableStats;
+    }
+    else
     {
-        nextSymbol = symbol->nextSymbol();
-        delete symbol;
-        symbol = nextSymbol;
+        delete m_pStats;
+        m_pStats = 0;
     }
 }
 
 /*!
- * \brief   Adds a symbol to the scope.
- * \param   name    The name of the new symbol.
- * \param   type    The type of the new symbol.
- * \param   use     The purpose of the new symbol.
- * \param   data    The constant data for the new symbol.
- * \return  true if symbol was added, otherwise false.
+ * \brief   Gets the table's statistics.
+ * \return  Pointer to the counters, or NULL if statistics are disabled.
  */
-bool SymbolTable::SymbolTableScope::addSymbol(const char *name, E_TYPE type,
-                                              E_USE use, const char *data)
+const SymbolTableStats* SymbolTable::stats() const
 {
-    if (!findSymbol(name).isNull())
-        return false;
+    return m_pStats;
+}
 
-    Symbol *newHead = new Symbol(name, type, use, data);
-    Symbol *oldHead = m_pHeadSymbol;
-    m_pHeadSymbol = newHead;
-    m_pHeadSymbol->setNextSymbol(oldHead);
+/*!
+ * \brief   Captures the symbols visible from the current scope.
+ * \return  A snapshot of the base symbols plus the innermost symbol of every
+ *          name bound in the table.
+ *
+ * The snapshot starts as a constant time copy of the base, so only the symbols
+ * declared in the table itself cost a path copy each.
+ */
+SymbolSnapshot SymbolTable::snapshot() const
+{
+    std::unique_lock<std::mutex> lock = lockWriters();
+    SymbolSnapshot snapshot(m_Base);
 
-    // If previous head existed, set it's previous symbol to new head
-    if (oldHead)
-        oldHead->setPrevSymbol(m_pHeadSymbol);
+    for (int i = 0; m_pImageSymbols && i < m_pImage->capacity(); i++)
+    {
+        if (!m_pImage->isEntryUsed(i) ||
+            m_pImageSymbols[i].load(std::memory_order_relaxed) ==
+                REMOVED_IMAGE_SYMBOL)
+            continue;
 
-    return true;
+        const SymbolImage::Entry &entry = m_pImage->m_pEntries[i];
+        snapshot.setSymbol(m_pImage->string(entry.m_Name),
+                           (E_TYPE)entry.m_Type, (E_USE)entry.m_Use,
+                           m_pImage->string(entry.m_ConstData));
+    }
+
+    m_Names.copyTo(snapshot);
+    return snapshot;
 }
 
 /*!
- * \brief   Removes a symbol from the scope.
- * \param   symbolName  The name of the symbol to be removed.
- * \return  true if symbol was removed, otherwise false.
+ * \brief   Saves the symbols visible from the current scope to a file, which
+ *          a later table can start from through SymbolImage::load().
+ * \param   path    The path of the image file, which is replaced.
+ * \return  true if the file was written, otherwise false.
+ */
+bool SymbolTable::saveImage(const char *path) const
+{
+    return SymbolImage::save(snapshot(), path);
+}
+
+/*!
+ * \brief   Finds a name in the image.
+ * \param   symbolName  The name to find.
+ * \param   hash        The hash of \p symbolName.
+ * \return  The index of the name's entry in the image, or -1 if the image
+ *          lacks it or it was removed from the table.
+ */
+int SymbolTable::findImageEntry(const char *symbolName, unsigned int hash) const
+{
+    if (!m_pImageSymbols)
+        return -1;
+
+    int entry = m_pImage->findEntry(symbolName, hash);
+    if (entry < 0 || m_pImageSymbols[entry].load(std::memory_order_acquire) ==
+                         REMOVED_IMAGE_SYMBOL)
+        return -1;
+    return entry;
+}
+
+/*!
+ * \brief   Finds the symbol of a name in the image.
+ * \param   symbolName  The name to find.
+ * \param   hash        The hash of \p symbolName.
+ * \return  Pointer to the symbol, or NULL if the image lacks it or it was
+ *          removed from the table.
+ *
+ * The symbol is built around the image's strings the first time it is found,
+ * and kept until it is removed or the table is destroyed. Concurrent readers
+ * may race to build it; one symbol is published and the others are freed.
  */
-bool SymbolTable::SymbolTableScope::removeSymbol(const char* symbolName)
+Symbol *SymbolTable::findImageSymbol(const char *symbolName,
+                                     unsigned int hash) const
 {
-    Symbol *symbol = findSymbolInternal(symbolName);
+    int entry = m_pImage->findEntry(symbolName, hash);
+    if (entry < 0)
+        return 0;
 
-    // If symbol doesn't exist in this scope
+    std::atomic<Symbol*> &slot = m_pImageSymbols[entry];
+    Symbol *symbol = slot.load(std::memory_order_acquire);
     if (!symbol)
-        return false;
+    {
+        Symbol *built = m_pImage->newSymbol(entry);
+        if (slot.compare_exchange_strong(symbol, built,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire))
+            symbol = built;
+        else
+            SymbolImage::deleteSymbol(built);
+    }
+
+    return symbol == REMOVED_IMAGE_SYMBOL ? 0 : symbol;
+}
+
+/*!
+ * \brief   Rebuilds the filter from every name in the table, base or image,
+ *          sizing it for their number.
+ */
+void SymbolTable::rebuildFilter()
+{
+    std::vector<unsigned int> hashes;
+    m_Names.collectHashes(hashes);
+    m_Base.collectHashes(hashes);
+
+    for (int i = 0; m_pImageSymbols && i < m_pImage->capacity(); i++)
+    {
+        if (m_pImage->isEntryUsed(i) &&
+            m_pImageSymbols[i].load(std::memory_order_relaxed) !=
+                REMOVED_IMAGE_SYMBOL)
+            hashes.push_back(m_pImage->m_pEntries[i].m_Hash);
+    }
+    m_Filter.rebuild(hashes, m_Concurrent);
+}
+
+/*!
+ * \brief   Locks the writer mutex, if the table is in concurrent mode.
+ * \return  The lock, which owns nothing outside of concurrent mode.
+ */
+std::unique_lock<std::mutex> SymbolTable::lockWriters() const
+{
+    std::unique_lock<std::mutex> lock(m_WriteMutex, std::defer_lock);
+    if (m_Concurrent)
+        lock.lock();
+    return lock;
+}
+
 
-    if (symbol == m_pHeadSymbol)
+
+/*!
+ * \brief   Instantiates a new, empty SymbolTableScope object.
+ * \param   mark    The arena position to rewind to when the scope is popped.
+ */
+SymbolTable::SymbolTableScope::SymbolTableScope(const SymbolArena::Mark &mark)
+    :m_pNextScope(0), m_Mark(mark), m_pHeadSymbol(0)
+{
+}
+
+/*!
+ * \brief   Adds a symbol to the head of the scope's list.
+ * \param   symbol  The symbol declared in the scope.
+ */
+void SymbolTable::SymbolTableScope::linkSymbol(Symbol *symbol)
+{
+    symbol->setPrevSymbol(0);
+    symbol->setNextSymbol(m_pHeadSymbol);
+    if (m_pHeadSymbol)
+        m_pHeadSymbol->setPrevSymbol(symbol);
+    m_pHeadSymbol = symbol;
+}
+
+/*!
+ * \brief   Removes a symbol from the scope's list without deleting it.
+ * \param   symbol  A symbol declared in the scope.
+ */
+void SymbolTable::SymbolTableScope::unlinkSymbol(Symbol *symbol)
+{
+    if (symbol->prevSymbol())
+        symbol->prevSymbol()->setNextSymbol(symbol->nextSymbol());
+    else
         m_pHeadSymbol = symbol->nextSymbol();
 
-    delete symbol;
-    return true;
+    if (symbol->nextSymbol())
+        symbol->nextSymbol()->setPrevSymbol(symbol->prevSymbol());
+
+    symbol->setPrevSymbol(0);
+    symbol->setNextSymbol(0);
 }
 
 /*!
- * \brief   Finds a symbol in the current scope, returning it.
- * \param   symbolName  The name of the symbol to be retrieved.
- * \return  A wrapper around the matching symbol, if found. Otherwise a wrapper
- *          around NULL.
+ * \brief   Gets the most recently declared symbol of the scope.
+ * \return  Pointer to the first symbol in the scope's list, or NULL.
  */
-SymbolPtr SymbolTable::SymbolTableScope::findSymbol(const char *symbolName)
+Symbol *SymbolTable::SymbolTableScope::headSymbol() const
 {
-    Symbol *symbol = findSymbolInternal(symbolName);
-    return SymbolPtr(symbol);
+    return m_pHeadSymbol;
 }
 
+
+
 /*!
- * \brief   Finds a symbol in the scope by matching names.
- * \param   symbolName  The name of the symbol to find.
- * \return  Pointer to matching symbol, or NULL.
+ * \brief   Instantiates a new SymbolNameTable object. The hash table is not
+ *          allocated until the first name is bound.
  */
-Symbol* SymbolTable::SymbolTableScope::findSymbolInternal(const char *symbolName)
+SymbolTable::SymbolNameTable::SymbolNameTable()
+    :m_Concurrent(false), m_pSlotArray(0), m_Count(0), m_Used(0)
 {
-    Symbol *symbol = m_pHeadSymbol;
+}
 
-    while (symbol)
+/*!
+ * \brief   Deletes a name table. The symbols belong to their scopes.
+ */
+SymbolTable::SymbolNameTable::~SymbolNameTable()
+{
+    SlotArray *slots = m_pSlotArray.load(std::memory_order_relaxed);
+    if (slots)
     {
-        if (!strcmp(symbolName, symbol->name()))
-            return symbol;
-        symbol = symbol->nextSymbol();
+        delete []slots->m_pKeys;
+        delete []slots->m_pSymbols;
+        delete slots;
     }
+}
 
+/*!
+ * \brief   Finds the innermost symbol of a name.
+ * \param   name    The name of the symbol to find.
+ * \param   hash    The hash of \p name.
+ * \param   probes  If not NULL, receives the number of slots inspected.
+ * \return  Pointer to the innermost matching symbol, or NULL.
+ */
+Symbol *SymbolTable::SymbolNameTable::find(const char *name, unsigned int hash,
+                                           int *probes) const
+{
+    Symbol *symbol;
+    findSlot(m_pSlotArray.load(std::memory_order_acquire), name, slotKey(hash),
+             &symbol, probes);
     return symbol;
 }
+
+/*!
+ * \brief   Prefetches the first key and symbol slots a name probes.
+ * \param   hash    The hash of the name.
+ */
+void SymbolTable::SymbolNameTable::prefetch(unsigned int hash) const
+{
+    const SlotArray *slots = m_pSlotArray.load(std::memory_order_acquire);
+    if (!slots)
+        return;
+
+    int slot = slotKey(hash) & (slots->m_Capacity - 1);
+    SYMBOL_PREFETCH(&slots->m_pKeys[slot]);
+    SYMBOL_PREFETCH(&slots->m_pSymbols[slot]);
+}
+
+/*!
+ * \brief   Binds a symbol's name to it, replacing the symbol it shadows.
+ * \param   symbol  The new innermost symbol of its name.
+ *
+ * The symbol is published with a release store, so a reader which finds it
+ * also sees it fully built. A new slot's symbol is stored before its key, so
+ * a reader whose key matches always finds a symbol beside it.
+ */
+void SymbolTable::SymbolNameTable::bind(Symbol *symbol)
+{
+    SlotArray *slots = m_pSlotArray.load(std::memory_order_relaxed);
+    unsigned int key = slotKey(symbol->hash());
+    Symbol *bound;
+    int slot = findSlot(slots, symbol->name(), key, &bound);
+    if (bound)
+    {
+        slots->m_pSymbols[slot].store(symbol, std::memory_order_release);
+        return;
+    }
+
+    // Keep the table at most three quarters full, counting tombstones
+    int capacity = slots ? slots->m_Capacity : 0;
+    if ((m_Used + 1) * 4 > capacity * 3)
+    {
+        // Only grow when live names, not tombstones, fill the table
+        resize(m_Count * 4 >= capacity ? capacity * 2 : capacity);
+        slots = m_pSlotArray.load(std::memory_order_relaxed);
+        slot = findSlot(slots, symbol->name(), key, &bound);
+    }
+
+    if (slots->m_pKeys[slot].load(std::memory_order_relaxed) == EMPTY_KEY)
+        m_Used++;
+    slots->m_pSymbols[slot].store(symbol, std::memory_order_release);
+    slots->m_pKeys[slot].store(key, std::memory_order_release);
+    m_Count++;
+}
+
+/*!
+ * \brief   Unbinds a symbol from its name, rebinding the symbol it shadowed.
+ * \param   symbol  The innermost symbol of its name.
+ *
+ * When nothing was shadowed the slot becomes a tombstone, so that names
+ * further along the probe sequence can still be found. Tombstones are dropped
+ * when the table is rehashed.
+ */
+void SymbolTable::SymbolNameTable::unbind(Symbol *symbol)
+{
+    SlotArray *slots = m_pSlotArray.load(std::memory_order_relaxed);
+    Symbol *bound;
+    int slot = findSlot(slots, symbol->name(), slotKey(symbol->hash()), &bound);
+    if (!bound)
+        return;
+
+    if (symbol->shadowedSymbol())
+    {
+        slots->m_pSymbols[slot].store(symbol->shadowedSymbol(),
+                                      std::memory_order_release);
+    }
+    else
+    {
+        slots->m_pKeys[slot].store(TOMBSTONE_KEY, std::memory_order_release);
+        m_Count--;
+    }
+}
+
+/*!
+ * \brief   Grows the hash table once, so that binding \p count more names
+ *          will not grow it again.
+ * \param   count   The number of names about to be bound.
+ */
+void SymbolTable::SymbolNameTable::reserve(int count)
+{
+    SlotArray *slots = m_pSlotArray.load(std::memory_order_relaxed);
+    int capacity = slots ? slots->m_Capacity : 0;
+    if ((m_Used + count) * 4 <= capacity * 3)
+        return;
+
+    int needed = FIRST_NAME_CAPACITY;
+    while (needed * 3 < (m_Count + count) * 4)
+        needed *= 2;
+    resize(needed > capacity ? needed : capacity);
+}
+
+/*!
+ * \brief   Sets the innermost symbol of every bound name in a snapshot.
+ * \param   snapshot    The snapshot to add the symbols to, replacing any of
+ *                      the same names.
+ */
+void SymbolTable::SymbolNameTable::copyTo(SymbolSnapshot &snapshot) const
+{
+    const SlotArray *slots = m_pSlotArray.load(std::memory_order_relaxed);
+    for (int i = 0; slots && i < slots->m_Capacity; i++)
+    {
+        if (slots->m_pKeys[i].load(std::memory_order_relaxed) < FIRST_NAME_KEY)
+            continue;
+
+        Symbol *symbol = slots->m_pSymbols[i].load(std::memory_order_relaxed);
+        snapshot.setSymbol(symbol->name(), symbol->type(), symbol->use(),
+                           symbol->constData());
+    }
+}
+
+/*!
+ * \brief   Appends the hash of every bound name to \p hashes.
+ * \param   hashes  The list to append to.
+ *
+ * Keys are not quite hashes, as the smallest hashes are moved clear of the
+ * markers, so the hashes are read from the symbols.
+ */
+void SymbolTable::SymbolNameTable::collectHashes(
+    std::vector<unsigned int> &hashes) const
+{
+    const SlotArray *slots = m_pSlotArray.load(std::memory_order_relaxed);
+    for (int i = 0; slots && i < slots->m_Capacity; i++)
+    {
+        if (slots->m_pKeys[i].load(std::memory_order_relaxed) >= FIRST_NAME_KEY)
+            hashes.push_back(
+                slots->m_pSymbols[i].load(std::memory_order_relaxed)->hash());
+    }
+}
+
+/*!
+ * \brief   Gets the key a name is stored under.
+ * \param   hash    The hash of the name.
+ * \return  \p hash, unless it would be mistaken for an empty slot or a
+ *          tombstone.
+ */
+unsigned int SymbolTable::SymbolNameTable::slotKey(unsigned int hash)
+{
+    return hash < FIRST_NAME_KEY ? hash + FIRST_NAME_KEY : hash;
+}
+
+/*!
+ * \brief   Finds a name by scanning for matching keys, then matching names.
+ * \param   slots   The hash table to probe, or NULL.
+ * \param   name    The name to find.
+ * \param   key     The slot key of \p name.
+ * \param   symbol  Receives the symbol bound to the name, or NULL.
+ * \param   probes  If not NULL, receives the number of slots inspected.
+ * \return  The slot of the name, or else the slot it should be bound at, or -1
+ *          if no table is allocated.
+ *
+ * Only the keys are read until one matches. A reader may then find a symbol of
+ * another name, if the slot was since unbound and reused, but never a symbol
+ * it cannot compare; the name comparison rejects it.
+ */
+int SymbolTable::SymbolNameTable::findSlot(const SlotArray *slots,
+                                           const char *name, unsigned int key,
+                                           Symbol **symbol, int *probes)
+{
+    *symbol = 0;
+    if (!slots)
+        return -1;
+
+    int mask = slots->m_Capacity - 1;
+    int firstTombstone = -1;
+    for (int i = key & mask; ; i = (i + 1) & mask)
+    {
+        if (probes)
+            (*probes)++;
+
+        unsigned int slotKey = slots->m_pKeys[i].load(std::memory_order_acquire);
+        if (slotKey == EMPTY_KEY)
+            return firstTombstone >= 0 ? firstTombstone : i;
+
+        if (slotKey == TOMBSTONE_KEY)
+        {
+            if (firstTombstone < 0)
+                firstTombstone = i;
+        }
+        else if (slotKey == key)
+        {
+            Symbol *bound = slots->m_pSymbols[i].load(std::memory_order_acquire);
+            if (!strcmp(name, bound->name()))
+            {
+                *symbol = bound;
+                return i;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief   Moves every binding into a new table, dropping tombstones.
+ * \param   capacity    The number of slots, a power of two.
+ *
+ * The new table is filled before it is published. In concurrent mode the old
+ * table is only freed once no reader can still be probing it.
+ */
+void SymbolTable::SymbolNameTable::resize(int capacity)
+{
+    if (capacity < FIRST_NAME_CAPACITY)
+        capacity = FIRST_NAME_CAPACITY;
+
+    SlotArray *oldSlots = m_pSlotArray.load(std::memory_order_relaxed);
+    SlotArray *slots = new SlotArray;
+    slots->m_Capacity = capacity;
+    slots->m_pKeys = new std::atomic<unsigned int>[capacity]();
+    slots->m_pSymbols = new std::atomic<Symbol*>[capacity]();
+    m_Used = m_Count;
+
+    int mask = capacity - 1;
+    for (int i = 0; oldSlots && i < oldSlots->m_Capacity; i++)
+    {
+        unsigned int key = oldSlots->m_pKeys[i].load(std::memory_order_relaxed);
+        if (key < FIRST_NAME_KEY)
+            continue;
+
+        int j = key & mask;
+        while (slots->m_pKeys[j].load(std::memory_order_relaxed) != EMPTY_KEY)
+            j = (j + 1) & mask;
+        slots->m_pKeys[j].store(key, std::memory_order_relaxed);
+        slots->m_pSymbols[j].store(
+            oldSlots->m_pSymbols[i].load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+    }
+
+    m_pSlotArray.store(slots, std::memory_order_release);
+
+    if (oldSlots)
+    {
+        if (m_Concurrent)
+            EpochReclaimer::synchronize();
+        delete []oldSlots->m_pKeys;
+        delete []oldSlots->m_pSymbols;
+        delete oldSlots;
+    }
+}
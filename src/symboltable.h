@@ -11,11 +11,39 @@
 #define SYMBOLTABLE_H
 
 #include "symbol.h"
+#include "symbolarena.h"
+#include "symbolfilter.h"
+#include "symbolimage.h"
+#include "symbolsnapshot.h"
+#include "symboltablestats.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 /*!
  * \brief   The SymbolTable class stores symbol names, type, uses, and constant
  *          data. Symbol names may not be reused on the same scope, but may be
  *          reused on different scopes.
+ *
+ * One hash table, shared by every scope, maps each name to its innermost
+ * symbol; that symbol links to the one it shadows in an outer scope. Each
+ * scope lists the symbols it declared, so popping it can restore what they
+ * shadowed. Lookups therefore cost the same at any scope depth.
+ *
+ * Scopes, symbols and their strings are bumped out of one arena. Pushing a
+ * scope marks the arena and popping rewinds it, so neither calls the heap.
+ *
+ * In concurrent mode any number of threads may call findSymbol() while one
+ * writer at a time changes the table. Readers never lock or wait; writers take
+ * a mutex, and wait for readers before memory they may see is reused.
+ *
+ * A table may start from a SymbolSnapshot, whose symbols act as part of the
+ * global scope without being copied. snapshot() captures the visible symbols
+ * in turn, so later tables can branch from the same state.
+ *
+ * A table may instead start from a SymbolImage mapped from a file. Its
+ * symbols likewise act as part of the global scope, and each is only built
+ * the first time it is found.
  */
 class SymbolTable
 {
@@ -23,6 +51,12 @@ public:
     /// Creates a new symbol table with a global scope.
     SymbolTable();
 
+    /// Creates a new symbol table whose global scope starts as \p base.
+    explicit SymbolTable(const SymbolSnapshot &base);
+
+    /// Creates a new symbol table whose global scope starts as \p image.
+    explicit SymbolTable(const SymbolImage &image);
+
     /// Deletes a symbol table and frees associated memory.
     ~SymbolTable();
 
@@ -38,52 +72,223 @@ public:
     /// Adds a symbol to the symbol table at the current scope.
     bool addSymbol(const char *name, E_TYPE type, E_USE use, const char *data);
 
+    /// Adds \p count symbols to the current scope at once.
+    int addSymbols(const SymbolDefinition *symbols, int count);
+
     /// Removes a symbol from the symbol table.
     void removeSymbol(const char *symbolName);
 
     /// Finds a symbol in the symbol table and returns it.
     SymbolPtr findSymbol(const char *symbolName) const;
 
+    /// Finds a batch of symbols, appending them to \p symbols in order.
+    void findSymbols(const char *const *symbolNames, int count,
+                     std::vector<SymbolPtr> &symbols) const;
+
+    /// Turns concurrent mode on or off, before the table is shared.
+    void setConcurrent(bool concurrent);
+
+    /// Saves every symbol visible from the current scope as an image file.
+    bool saveImage(const char *path) const;
+
+    /// Returns a snapshot of every symbol visible from the current scope.
+    SymbolSnapshot snapshot() const;
+
+    /// Turns the collection of statistics on or off.
+    void setStatsEnabled(bool enabled);
+
+    /// Returns the table's statistics, or NULL if they are disabled.
+    const SymbolTableStats *stats() const;
+
+    /// Returns the number of bytes held for scopes, symbols and strings.
+    size_t memoryUsage() const;
+
 private:
+    // Tables own their symbols and are not copyable
+    SymbolTable(const SymbolTable&);
+    SymbolTable& operator=(const SymbolTable&);
+
+    /// Locks out other writers when in concurrent mode.
+    std::unique_lock<std::mutex> lockWriters() const;
+
+    /// Adds a symbol to the current scope, once writers are locked out.
+    bool addSymbolLocked(const char *name, unsigned int hash, E_TYPE type,
+                         E_USE use, const char *data);
+
+    /// Checks that a name is free in the current scope, and finds what a new
+    /// symbol of that name would shadow.
+    bool canDeclare(const char *name, unsigned int hash, Symbol **shadowed);
+
+    /// Declares a new symbol in the current scope, shadowing \p shadowed.
+    void declareSymbol(Symbol *symbol, Symbol *shadowed);
+
+    /// Finds the innermost symbol named \p symbolName with hash \p hash.
+    Symbol *findSymbolInternal(const char *symbolName, unsigned int hash) const;
+
+    /// Finds the entry of a name in the image, unless it was removed.
+    int findImageEntry(const char *symbolName, unsigned int hash) const;
+
+    /// Finds the symbol of a name in the image, building it if need be.
+    Symbol *findImageSymbol(const char *symbolName, unsigned int hash) const;
+
+    /// Finds a batch of symbols, within any read section needed.
+    void findSymbolsInternal(const char *const *symbolNames, int count,
+                             std::vector<SymbolPtr> &symbols) const;
+
+    /// Rebuilds the filter to fit every name in the table, base and image.
+    void rebuildFilter();
+
     /*!
-     * \brief   The SymbolTableScope class contains the symbols for a single
-     *          scope within the symbol table. It is an implementation detail
-     *          not for client use.
+     * \brief   The SymbolTableScope class lists the symbols declared in a
+     *          single scope within the symbol table, in order to undo them
+     *          when the scope is popped. It is an implementation detail not
+     *          for client use.
      */
     class SymbolTableScope
     {
     public:
-        /// Creates a new symbol table scope.
-        SymbolTableScope();
-
-        /// Deletes a symbol table scope.
-        ~SymbolTableScope();
+        /// Creates a new symbol table scope, which began at \p mark.
+        SymbolTableScope(const SymbolArena::Mark &mark);
 
-        /// Adds a symbol to the scope.
-        bool addSymbol(const char *name, E_TYPE type, E_USE use, const char *data);
+        /// Adds a symbol to the scope's list.
+        void linkSymbol(Symbol *symbol);
 
-        /// Removes a symbol from the scope.
-        bool removeSymbol(const char *symbolName);
+        /// Removes a symbol from the scope's list.
+        void unlinkSymbol(Symbol *symbol);
 
-        /// Finds a symbol in the scope and returns it.
-        SymbolPtr findSymbol(const char *symbolName);
+        /// Returns the first symbol in the scope's list.
+        Symbol *headSymbol() const;
 
         /// Pointer to the next scope in the list.
         SymbolTableScope *m_pNextScope;
 
+        /// The arena position from before the scope was pushed.
+        SymbolArena::Mark m_Mark;
+
     private:
         /// Pointer to the first symbol in the scope.
         Symbol *m_pHeadSymbol;
+    };
 
-        /// Internal implementation to return the actual symbol type.
-        Symbol* findSymbolInternal(const char *symbolName);
+    /*!
+     * \brief   The SymbolNameTable class maps names to their innermost
+     *          symbols. It is an open-addressing hash table with linear
+     *          probing, and an implementation detail not for client use.
+     *
+     * The table is kept as parallel arrays: a dense array of name hashes,
+     * which probing scans, and the symbols, which are only read when a hash
+     * matches. A probe thus inspects sixteen slots per cache line. The slots
+     * are atomic so that readers may probe while the single writer binds and
+     * unbinds; a grown table replaces the old one, which is freed once no
+     * reader can see it.
+     */
+    class SymbolNameTable
+    {
+    public:
+        /// Creates an empty name table.
+        SymbolNameTable();
+
+        /// Deletes the name table, but not the symbols in it.
+        ~SymbolNameTable();
+
+        /// Finds the innermost symbol named \p name.
+        Symbol *find(const char *name, unsigned int hash, int *probes=0) const;
+
+        /// Starts loading the first slot a name with \p hash probes.
+        void prefetch(unsigned int hash) const;
+
+        /// Makes \p symbol the innermost symbol of its name.
+        void bind(Symbol *symbol);
+
+        /// Makes the symbol shadowed by \p symbol the innermost of its name.
+        void unbind(Symbol *symbol);
+
+        /// Makes room to bind \p count more names without growing.
+        void reserve(int count);
+
+        /// Sets every bound symbol in \p snapshot.
+        void copyTo(SymbolSnapshot &snapshot) const;
+
+        /// Appends the hash of every bound name to \p hashes.
+        void collectHashes(std::vector<unsigned int> &hashes) const;
+
+        /// Whether readers may probe while the table is written.
+        bool m_Concurrent;
+
+    private:
+        /// The slots of the hash table, published to readers as one.
+        struct SlotArray
+        {
+            /// The number of slots, a power of two.
+            int m_Capacity;
+
+            /// The key of each slot: its name's hash, or a marker for an
+            /// empty slot or a tombstone.
+            std::atomic<unsigned int> *m_pKeys;
+
+            /// The symbol of each slot holding a name.
+            std::atomic<Symbol*> *m_pSymbols;
+        };
+
+        // Name tables own their slots and are not copyable
+        SymbolNameTable(const SymbolNameTable&);
+        SymbolNameTable& operator=(const SymbolNameTable&);
+
+        /// Returns the slot key of a name with \p hash.
+        static unsigned int slotKey(unsigned int hash);
+
+        /// Finds the slot of \p name, or the slot it should be added at.
+        static int findSlot(const SlotArray *slots, const char *name,
+                            unsigned int key, Symbol **symbol,
+                            int *probes=0);
+
+        /// Rehashes the symbols into a table of \p capacity slots.
+        void resize(int capacity);
+
+        /// The hash table, or NULL until the first name is bound.
+        std::atomic<SlotArray*> m_pSlotArray;
+
+        /// The number of names bound to a symbol.
+        int m_Count;
+
+        /// The number of slots holding names or tombstones.
+        int m_Used;
     };
 
     /// Pointer to the first (most local) scope in the table.
     SymbolTableScope *m_pHeadScope;
 
-    /// Counter for the number of scopes in the symbol table.
-    int m_Scope;
+    /// Counter for the number of scopes in the symbol table. Readers see it
+    /// in concurrent mode, to count lookups by depth.
+    std::atomic<int> m_Scope;
+
+    /// The memory of every scope, symbol and symbol string.
+    SymbolArena m_Arena;
+
+    /// The innermost symbol of every name, across all scopes.
+    SymbolNameTable m_Names;
+
+    /// Symbols of the global scope which the table started from.
+    SymbolSnapshot m_Base;
+
+    /// Symbols of the global scope mapped from a file, or NULL.
+    const SymbolImage *m_pImage;
+
+    /// The symbol built for each entry of the image, NULL until it is first
+    /// found, or a marker once removed.
+    std::atomic<Symbol*> *m_pImageSymbols;
+
+    /// Rules out names bound in neither the name table nor the base.
+    SymbolFilter m_Filter;
+
+    /// Whether readers may look symbols up while the table is written.
+    bool m_Concurrent;
+
+    /// Serializes writers in concurrent mode.
+    mutable std::mutex m_WriteMutex;
+
+    /// Counters of the table's operations, or NULL when not collected.
+    SymbolTableStats *m_pStats;
 };
 
 #endif//SYMBOLTABLE_H
@@ -0,0 +1,292 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        symboltablestats.cpp
+ *
+ * \brief       Defines the methods of the SymbolTableStats class.
+ */
+#include "symboltablestats.h"
+#include <sstream>
+
+/// Clamps a scope depth to the counters kept for it.
+static int statsDepth(int depth)
+{
+    if (depth < 0)
+        return 0;
+    return depth < SYMBOL_STATS_DEPTHS ? depth : SYMBOL_STATS_DEPTHS - 1;
+}
+
+/*!
+ * \brief   Instantiates a set of zeroed counters.
+ */
+SymbolTableStats::SymbolTableStats()
+{
+    reset();
+}
+
+/*!
+ * \brief   Counts an attempt to add a symbol.
+ * \param   added   Whether the symbol was added, rather than refused.
+ */
+void SymbolTableStats::recordAdd(bool added)
+{
+    if (added)
+        m_Adds.fetch_add(1, std::memory_order_relaxed);
+    else
+        m_AddConflicts.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*!
+ * \brief   Counts a removal of a symbol.
+ */
+void SymbolTableStats::recordRemove()
+{
+    m_Removes.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*!
+ * \brief   Counts a lookup.
+ * \param   depth       The scope depth of the table at the lookup.
+ * \param   hit         Whether a symbol was found.
+ * \param   filtered    Whether the filter rejected the name.
+ * \param   probes      The number of name table slots inspected.
+ */
+void SymbolTableStats::recordFind(int depth, bool hit, bool filtered, int probes)
+{
+    depth = statsDepth(depth);
+    m_Finds[depth].fetch_add(1, std::memory_order_relaxed);
+    if (hit)
+        m_Hits[depth].fetch_add(1, std::memory_order_relaxed);
+
+    if (filtered)
+    {
+        m_FilterRejects.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    m_Probes.fetch_add(probes, std::memory_order_relaxed);
+    raise(m_MaxProbes, probes);
+}
+
+/*!
+ * \brief   Counts a pushed scope.
+ * \param   depth   The scope depth after the push.
+ */
+void SymbolTableStats::recordPush(int depth)
+{
+    m_Pushes.fetch_add(1, std::memory_order_relaxed);
+    raise(m_MaxDepth, depth);
+}
+
+/*!
+ * \brief   Counts a popped scope.
+ */
+void SymbolTableStats::recordPop()
+{
+    m_Pops.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*!
+ * \brief   Zeroes every counter.
+ */
+void SymbolTableStats::reset()
+{
+    m_Adds.store(0, std::memory_order_relaxed);
+    m_AddConflicts.store(0, std::memory_order_relaxed);
+    m_Removes.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < SYMBOL_STATS_DEPTHS; i++)
+    {
+        m_Finds[i].store(0, std::memory_order_relaxed);
+        m_Hits[i].store(0, std::memory_order_relaxed);
+    }
+    m_FilterRejects.store(0, std::memory_order_relaxed);
+    m_Probes.store(0, std::memory_order_relaxed);
+    m_MaxProbes.store(0, std::memory_order_relaxed);
+    m_Pushes.store(0, std::memory_order_relaxed);
+    m_Pops.store(0, std::memory_order_relaxed);
+    m_MaxDepth.store(0, std::memory_order_relaxed);
+}
+
+/// Returns the number of symbols added.
+unsigned long SymbolTableStats::adds() const
+{
+    return m_Adds.load(std::memory_order_relaxed);
+}
+
+/// Returns the number of adds refused because the name was taken.
+unsigned long SymbolTableStats::addConflicts() const
+{
+    return m_AddConflicts.load(std::memory_order_relaxed);
+}
+
+/// Returns the number of symbols removed.
+unsigned long SymbolTableStats::removes() const
+{
+    return m_Removes.load(std::memory_order_relaxed);
+}
+
+/// Returns the number of lookups.
+unsigned long SymbolTableStats::finds() const
+{
+    unsigned long finds = 0;
+    for (int i = 0; i < SYMBOL_STATS_DEPTHS; i++)
+        finds += findsAtDepth(i);
+    return finds;
+}
+
+/// Returns the number of lookups which found a symbol.
+unsigned long SymbolTableStats::hits() const
+{
+    unsigned long hits = 0;
+    for (int i = 0; i < SYMBOL_STATS_DEPTHS; i++)
+        hits += hitsAtDepth(i);
+    return hits;
+}
+
+/// Returns the number of lookups which found nothing.
+unsigned long SymbolTableStats::misses() const
+{
+    return finds() - hits();
+}
+
+/// Returns the number of lookups the filter rejected.
+unsigned long SymbolTableStats::filterRejects() const
+{
+    return m_FilterRejects.load(std::memory_order_relaxed);
+}
+
+/// Returns the number of lookups made at scope \p depth.
+unsigned long SymbolTableStats::findsAtDepth(int depth) const
+{
+    return m_Finds[statsDepth(depth)].load(std::memory_order_relaxed);
+}
+
+/// Returns the number of lookups made at scope \p depth which found a symbol.
+unsigned long SymbolTableStats::hitsAtDepth(int depth) const
+{
+    return m_Hits[statsDepth(depth)].load(std::memory_order_relaxed);
+}
+
+/// Returns the mean number of slots inspected by lookups the filter passed.
+double SymbolTableStats::averageProbeLength() const
+{
+    unsigned long probed = finds() - filterRejects();
+    return probed ? (double)m_Probes.load(std::memory_order_relaxed) / probed
+                  : 0.0;
+}
+
+/// Returns the most slots inspected by one lookup.
+int SymbolTableStats::maxProbeLength() const
+{
+    return m_MaxProbes.load(std::memory_order_relaxed);
+}
+
+/// Returns the number of scopes pushed.
+unsigned long SymbolTableStats::pushes() const
+{
+    return m_Pushes.load(std::memory_order_relaxed);
+}
+
+/// Returns the number of scopes popped.
+unsigned long SymbolTableStats::pops() const
+{
+    return m_Pops.load(std::memory_order_relaxed);
+}
+
+/// Returns the deepest scope pushed.
+int SymbolTableStats::maxDepth() const
+{
+    return m_MaxDepth.load(std::memory_order_relaxed);
+}
+
+/*!
+ * \brief   Formats the counters for a person to read.
+ * \return  The counters, one group per line, then a line per scope depth with
+ *          lookups. The last depth also counts every deeper scope.
+ */
+std::string SymbolTableStats::toText() const
+{
+    std::ostringstream text;
+    text << "symbol table stats\n"
+         << "  adds:          " << adds()
+         << " (conflicts " << addConflicts() << ")\n"
+         << "  removes:       " << removes() << "\n"
+         << "  finds:         " << finds() << " (hits " << hits()
+         << ", misses " << misses()
+         << ", filter rejects " << filterRejects() << ")\n"
+         << "  probe length:  average " << averageProbeLength()
+         << ", max " << maxProbeLength() << "\n"
+         << "  scopes:        pushed " << pushes() << ", popped " << pops()
+         << ", max depth " << maxDepth() << "\n";
+
+    for (int i = 0; i < SYMBOL_STATS_DEPTHS; i++)
+    {
+        unsigned long finds = findsAtDepth(i);
+        if (!finds)
+            continue;
+
+        unsigned long hits = hitsAtDepth(i);
+        text << "  depth " << i << (i == SYMBOL_STATS_DEPTHS - 1 ? "+" : "")
+             << ": finds " << finds << ", hits " << hits
+             << ", misses " << finds - hits << "\n";
+    }
+
+    return text.str();
+}
+
+/*!
+ * \brief   Formats the counters for a tool to read.
+ * \return  A JSON object of the counters. Its "depths" array holds an object
+ *          for each scope depth with lookups; the last depth also counts every
+ *          deeper scope.
+ */
+std::string SymbolTableStats::toJson() const
+{
+    std::ostringstream json;
+    json << "{\"adds\":" << adds()
+         << ",\"addConflicts\":" << addConflicts()
+         << ",\"removes\":" << removes()
+         << ",\"finds\":" << finds()
+         << ",\"hits\":" << hits()
+         << ",\"misses\":" << misses()
+         << ",\"filterRejects\":" << filterRejects()
+         << ",\"averageProbeLength\":" << averageProbeLength()
+         << ",\"maxProbeLength\":" << maxProbeLength()
+         << ",\"pushes\":" << pushes()
+         << ",\"pops\":" << pops()
+         << ",\"maxDepth\":" << maxDepth()
+         << ",\"depths\":[";
+
+    bool first = true;
+    for (int i = 0; i < SYMBOL_STATS_DEPTHS; i++)
+    {
+        unsigned long finds = findsAtDepth(i);
+        if (!finds)
+            continue;
+
+        unsigned long hits = hitsAtDepth(i);
+        json << (first ? "" : ",") << "{\"depth\":" << i
+             << ",\"finds\":" << finds << ",\"hits\":" << hits
+             << ",\"misses\":" << finds - hits << "}";
+        first = false;
+    }
+
+    json << "]}";
+    return json.str();
+}
+
+/*!
+ * \brief   Raises a maximum, which other threads may be raising too.
+ * \param   maximum The maximum to raise.
+ * \param   value   The value it must be at least.
+ */
+void SymbolTableStats::raise(std::atomic<int> &maximum, int value)
+{
+    int current = maximum.load(std::memory_order_relaxed);
+    while (current < value &&
+           !maximum.compare_exchange_weak(current, value,
+                                          std::memory_order_relaxed))
+        ;
+}
@@ -0,0 +1,108 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        symboltablestats.h
+ *
+ * \brief       Declares the structure of the SymbolTableStats class.
+ */
+#ifndef SYMBOLTABLESTATS_H
+#define SYMBOLTABLESTATS_H
+
+#include <atomic>
+#include <string>
+
+/// The number of scope depths counted apart; deeper scopes share the last.
+#define SYMBOL_STATS_DEPTHS     16
+
+/*!
+ * \brief   The SymbolTableStats class counts what a symbol table is asked to
+ *          do, so its behavior under a real workload can be measured.
+ *
+ * Lookups are counted by the scope depth of the table when they were made.
+ * Probe lengths count the name table slots a lookup inspected; lookups which
+ * the filter rejected inspect none and are counted apart. Counters may be
+ * updated from several threads at once.
+ */
+class SymbolTableStats
+{
+public:
+    /// Creates a set of zeroed counters.
+    SymbolTableStats();
+
+    /// Counts an attempt to add a symbol.
+    void recordAdd(bool added);
+
+    /// Counts a removal of a symbol.
+    void recordRemove();
+
+    /// Counts a lookup made at scope \p depth.
+    void recordFind(int depth, bool hit, bool filtered, int probes);
+
+    /// Counts a scope pushed to \p depth.
+    void recordPush(int depth);
+
+    /// Counts a scope popped.
+    void recordPop();
+
+    /// Zeroes every counter.
+    void reset();
+
+    /// Getters
+    unsigned long adds() const;
+    unsigned long addConflicts() const;
+    unsigned long removes() const;
+    unsigned long finds() const;
+    unsigned long hits() const;
+    unsigned long misses() const;
+    unsigned long filterRejects() const;
+    unsigned long findsAtDepth(int depth) const;
+    unsigned long hitsAtDepth(int depth) const;
+    double averageProbeLength() const;
+    int maxProbeLength() const;
+    unsigned long pushes() const;
+    unsigned long pops() const;
+    int maxDepth() const;
+
+    /// Returns the counters as lines of text.
+    std::string toText() const;
+
+    /// Returns the counters as a JSON object.
+    std::string toJson() const;
+
+private:
+    // Stats are shared by address and are not copyable
+    SymbolTableStats(const SymbolTableStats&);
+    SymbolTableStats& operator=(const SymbolTableStats&);
+
+    /// Raises \p maximum to \p value if it is larger.
+    static void raise(std::atomic<int> &maximum, int value);
+
+    /// Symbols added, and adds refused because the name was taken.
+    std::atomic<unsigned long> m_Adds, m_AddConflicts;
+
+    /// Symbols removed.
+    std::atomic<unsigned long> m_Removes;
+
+    /// Lookups, and lookups which found a symbol, by scope depth.
+    std::atomic<unsigned long> m_Finds[SYMBOL_STATS_DEPTHS];
+    std::atomic<unsigned long> m_Hits[SYMBOL_STATS_DEPTHS];
+
+    /// Lookups the filter rejected.
+    std::atomic<unsigned long> m_FilterRejects;
+
+    /// Slots inspected by lookups which reached the name table.
+    std::atomic<unsigned long> m_Probes;
+
+    /// The most slots inspected by one lookup.
+    std::atomic<int> m_MaxProbes;
+
+    /// Scopes pushed and popped.
+    std::atomic<unsigned long> m_Pushes, m_Pops;
+
+    /// The deepest scope pushed.
+    std::atomic<int> m_MaxDepth;
+};
+
+#endif//SYMBOLTABLESTATS_H
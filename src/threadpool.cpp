@@ -0,0 +1,135 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        threadpool.cpp
+ *
+ * \brief       Defines the methods of the ThreadPool class.
+ */
+#include "threadpool.h"
+
+/*!
+ * \brief   Instantiates a pool and starts its worker threads.
+ * \param threadCount   The number of threads to run tasks on, counting the
+ *                      caller of run(). Zero picks the hardware thread count.
+ */
+ThreadPool::ThreadPool(int threadCount)
+    :m_pTask(0), m_TaskCount(0), m_NextTask(0), m_Unfinished(0),
+     m_Generation(0), m_Stopping(false)
+{
+    if (threadCount <= 0)
+        threadCount = (int)std::thread::hardware_concurrency();
+    if (threadCount <= 0)
+        threadCount = 1;
+
+    for (int i = 1; i < threadCount; i++)
+        m_Workers.push_back(std::thread(&ThreadPool::work, this));
+}
+
+/*!
+ * \brief   Destroys the pool once its workers have finished.
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_JobStarted.notify_all();
+
+    for (size_t i = 0; i < m_Workers.size(); i++)
+        m_Workers[i].join();
+}
+
+/*!
+ * \brief   Gets the number of threads tasks are run on.
+ * \return  The worker count plus one for the calling thread.
+ */
+int ThreadPool::threadCount() const
+{
+    return (int)m_Workers.size() + 1;
+}
+
+/*!
+ * \brief   Runs a job of \p count numbered tasks across the pool.
+ * \param count The number of tasks.
+ * \param task  Called once with each task number, from any thread of the pool.
+ *
+ * Tasks are handed out in increasing order, but may finish in any order.
+ */
+void ThreadPool::run(int count, const std::function<void(int)> &task)
+{
+    if (count <= 0)
+        return;
+
+    std::lock_guard<std::mutex> runLock(m_RunMutex);
+    unsigned generation;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_pTask = &task;
+        m_TaskCount = count;
+        m_NextTask = 0;
+        m_Unfinished = count;
+        generation = ++m_Generation;
+    }
+    m_JobStarted.notify_all();
+
+    runTasks(generation);
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (m_Unfinished)
+        m_JobFinished.wait(lock);
+    m_pTask = 0;
+}
+
+/*!
+ * \brief   Waits for jobs and helps run them until the pool stops.
+ */
+void ThreadPool::work()
+{
+    unsigned generation = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            while (!m_Stopping && generation == m_Generation)
+                m_JobStarted.wait(lock);
+            if (m_Stopping)
+                return;
+            generation = m_Generation;
+        }
+        runTasks(generation);
+    }
+}
+
+/*!
+ * \brief   Claims and runs tasks of one job until all are claimed.
+ * \param generation    The job to work on. A worker waking late must not claim
+ *                      tasks of a later job with an earlier job's task.
+ *
+ * Tasks are claimed under the lock; they are meant to be coarse chunks of work,
+ * so the cost is small, and a job cannot finish while one of its tasks runs.
+ */
+void ThreadPool::runTasks(unsigned generation)
+{
+    for (;;)
+    {
+        const std::function<void(int)> *task;
+        int i;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (generation != m_Generation || m_NextTask >= m_TaskCount)
+                return;
+            task = m_pTask;
+            i = m_NextTask++;
+        }
+
+        (*task)(i);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (--m_Unfinished == 0)
+            m_JobFinished.notify_all();
+    }
+}
@@ -0,0 +1,86 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        threadpool.h
+ *
+ * \brief       Declares the structure of the ThreadPool class.
+ */
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * \brief   The ThreadPool class runs numbered tasks on a fixed set of worker
+ *          threads.
+ *
+ * One job runs at a time. The thread calling run() works on the job too, so a
+ * pool of N threads has N - 1 workers.
+ */
+class ThreadPool
+{
+public:
+    /// Creates a pool; a count of zero uses one thread per hardware thread.
+    ThreadPool(int threadCount=0);
+
+    /// Stops and joins the worker threads.
+    ~ThreadPool();
+
+    /// Returns the number of threads which run tasks, including the caller.
+    int threadCount() const;
+
+    /// Runs task(0) through task(count - 1), returning when all have finished.
+    void run(int count, const std::function<void(int)> &task);
+
+private:
+    // Pools own threads and are not copyable
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    /// The loop each worker thread runs until the pool is destroyed.
+    void work();
+
+    /// Runs tasks of job \p generation until none are left to claim.
+    void runTasks(unsigned generation);
+
+    /// The worker threads.
+    std::vector<std::thread> m_Workers;
+
+    /// Serializes calls to run().
+    std::mutex m_RunMutex;
+
+    /// Guards the job fields below and the condition variables.
+    std::mutex m_Mutex;
+
+    /// Signals workers that a job has started or the pool is stopping.
+    std::condition_variable m_JobStarted;
+
+    /// Signals the caller of run() that the last task has finished.
+    std::condition_variable m_JobFinished;
+
+    /// The task of the current job.
+    const std::function<void(int)> *m_pTask;
+
+    /// The number of tasks in the current job.
+    int m_TaskCount;
+
+    /// The next task number to hand out.
+    int m_NextTask;
+
+    /// The number of tasks of the current job not yet finished.
+    int m_Unfinished;
+
+    /// Incremented for every job, so workers can tell a new job from an old.
+    unsigned m_Generation;
+
+    /// Set when the pool is being destroyed.
+    bool m_Stopping;
+};
+
+#endif // THREADPOOL_H
@@ -9,8 +9,9 @@
  */
 #include "token.h"
 
-Token::Token(std::string lexeme, std::string type)
-    :m_Lexeme(lexeme), m_Type(type)
+Token::Token(std::string lexeme, std::string type, int line)
+    :m_Lexeme(lexeme), m_Type(type), m_Line(line), m_Column(0),
+     m_LeadingSpace(false)
 {
 }
 
@@ -31,3 +32,33 @@ std::string Token::type() const
 {
     return m_Type;
 }
+
+/*!
+ * \brief Gets the line of the source code file where the token was found.
+ * \return The line, counting from 1, or 0 if it is not known.
+ */
+int Token::line() const
+{
+    return m_Line;
+}
+
+/*!
+ * \brief Gets whether whitespace or a comment came between the token and the
+ *        one before it, as between a macro's name and a '(' which does not
+ *        open its parameters.
+ * \return true if the token was spaced from the one before it, otherwise
+ *         false.
+ */
+bool Token::leadingSpace() const
+{
+    return m_LeadingSpace;
+}
+
+/*!
+ * \brief Sets whether whitespace or a comment came before the token.
+ * \param leadingSpace  true if the token was spaced from the one before it.
+ */
+void Token::setLeadingSpace(bool leadingSpace)
+{
+    m_LeadingSpace = leadingSpace;
+}
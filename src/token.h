@@ -19,7 +19,7 @@
 class Token
 {
 public:
-    Token(std::string lexeme, std::string type);
+    Token(std::string lexeme, std::string type, int line = 0);
 
     /// Gets the specific instance of the generic token type.
     std::string lexeme() const;
@@ -27,6 +27,15 @@ public:
     /// Gets the token's generic type.
     std::string type() const;
 
+    /// Gets the line the token was found on, or 0 if it is not known.
+    int line() const;
+
+    /// Gets whether whitespace or a comment came before the token.
+    bool leadingSpace() const;
+
+    /// Sets whether whitespace or a comment came before the token.
+    void setLeadingSpace(bool leadingSpace);
+
 private:
     /// The specific instance of the generic token type.
     std::string m_Lexeme;
@@ -42,6 +51,9 @@ private:
 
     /// The column of the source code file where the token begins.
     int m_Column;
+
+    /// Whether whitespace or a comment came before the token.
+    bool m_LeadingSpace;
 };
 
 #endif // TOKEN_H
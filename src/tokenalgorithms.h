@@ -0,0 +1,174 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        tokenalgorithms.h
+ *
+ * \brief       Declares parallel algorithms over the tokens of a TokenList.
+ *
+ * Each algorithm takes a snapshot of the list's nodes, splits it into chunks
+ * and runs the chunks on a ThreadPool. Results keep the order of the list.
+ * Lists shorter than one chunk are processed on the calling thread alone.
+ *
+ * The functions passed in are called concurrently, so they may only read
+ * shared state, such as a symbol table nobody is writing to.
+ */
+#ifndef TOKENALGORITHMS_H
+#define TOKENALGORITHMS_H
+
+#include <vector>
+#include "threadpool.h"
+#include "token.h"
+#include "tokenlist.h"
+
+/// The smallest number of tokens worth handing to another thread.
+#define PARALLEL_MIN_CHUNK  4096
+
+/// The number of chunks given to each thread, to even out uneven chunks.
+#define PARALLEL_CHUNKS_PER_THREAD  4
+
+/*!
+ * \brief   Picks the number of chunks to split \p length tokens into.
+ * \param length    The number of tokens.
+ * \param pool      The pool the chunks will run on.
+ * \return  At least one chunk, and no chunk smaller than PARALLEL_MIN_CHUNK
+ *          unless there is only one.
+ */
+inline int tokenChunkCount(int length, const ThreadPool &pool)
+{
+    int chunks = pool.threadCount() * PARALLEL_CHUNKS_PER_THREAD;
+    int maxChunks = length / PARALLEL_MIN_CHUNK;
+    if (chunks > maxChunks)
+        chunks = maxChunks;
+    return chunks < 1 ? 1 : chunks;
+}
+
+/*!
+ * \brief   Collects the nodes of a list so they can be split into chunks.
+ * \param tokens    The list to collect from.
+ * \param nodes     Receives the nodes, in order.
+ */
+template <typename List, typename Node>
+void collectTokenNodes(List &tokens, std::vector<Node*> &nodes)
+{
+    nodes.reserve(tokens.length());
+    for (typename List::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+        nodes.push_back(const_cast<Node*>(it.node()));
+}
+
+/*!
+ * \brief   Runs \p chunkFunction(chunk, first, last) over chunks of \p length
+ *          items.
+ * \param length        The number of items.
+ * \param pool          The pool to run chunks on.
+ * \param chunkFunction Called with each chunk number and its half-open range
+ *                      of item indexes.
+ * \return  The number of chunks used.
+ */
+template <typename ChunkFunction>
+int forEachTokenChunk(int length, ThreadPool &pool, ChunkFunction chunkFunction)
+{
+    int chunks = tokenChunkCount(length, pool);
+    if (chunks == 1)
+        chunkFunction(0, 0, length);
+    else
+        pool.run(chunks, [&](int chunk) {
+            chunkFunction(chunk, (int)((long long)length * chunk / chunks),
+                          (int)((long long)length * (chunk + 1) / chunks));
+        });
+    return chunks;
+}
+
+/*!
+ * \brief   Replaces every token of a list with the result of \p function.
+ * \param tokens    The list to transform.
+ * \param function  Called with each token; returns the token to keep in its
+ *                  place. Returning a different token deletes the old one.
+ * \param pool      The pool to run on.
+ *
+ * The list's index, if it has one, is rebuilt on its next query.
+ */
+template <typename Function>
+void parallelTransform(TokenList &tokens, Function function, ThreadPool &pool)
+{
+    std::vector<TokenNode*> nodes;
+    collectTokenNodes(tokens, nodes);
+
+    forEachTokenChunk((int)nodes.size(), pool, [&](int, int first, int last) {
+        for (int i = first; i < last; i++)
+        {
+            Token *token = nodes[i]->token();
+            Token *replacement = function(token);
+            if (replacement != token)
+            {
+                nodes[i]->setToken(replacement);
+                delete token;
+            }
+        }
+    });
+    tokens.invalidateIndex();
+}
+
+/*!
+ * \brief   Removes and deletes every token of a list failing \p predicate.
+ * \param tokens    The list to compact. Kept tokens stay in order.
+ * \param predicate Called with each token; returns true to keep it.
+ * \param pool      The pool to evaluate the predicate on.
+ * \return  The number of tokens removed.
+ *
+ * The predicate runs in parallel; unlinking is a single serial pass.
+ */
+template <typename Predicate>
+int parallelFilter(TokenList &tokens, Predicate predicate, ThreadPool &pool)
+{
+    std::vector<TokenNode*> nodes;
+    collectTokenNodes(tokens, nodes);
+    std::vector<char> keep(nodes.size());
+
+    forEachTokenChunk((int)nodes.size(), pool, [&](int, int first, int last) {
+        for (int i = first; i < last; i++)
+            keep[i] = predicate(nodes[i]->token()) ? 1 : 0;
+    });
+
+    int removed = 0;
+    for (size_t i = 0; i < nodes.size(); i++)
+        if (!keep[i])
+        {
+            Token *token = nodes[i]->token();
+            tokens.remove(nodes[i]);
+            delete token;
+            removed++;
+        }
+    return removed;
+}
+
+/*!
+ * \brief   Counts the tokens of a list satisfying \p predicate.
+ * \param tokens    The list to count.
+ * \param predicate Called with each token; returns true to count it.
+ * \param pool      The pool to run on.
+ * \return  The number of tokens for which \p predicate returned true.
+ */
+template <typename Predicate>
+int parallelCountIf(const TokenList &tokens, Predicate predicate, ThreadPool &pool)
+{
+    std::vector<TokenNode*> nodes;
+    collectTokenNodes(tokens, nodes);
+    std::vector<int> counts(tokenChunkCount((int)nodes.size(), pool), 0);
+
+    forEachTokenChunk((int)nodes.size(), pool, [&](int chunk, int first, int last) {
+        int count = 0;
+        for (int i = first; i < last; i++)
+            if (predicate(nodes[i]->token()))
+                count++;
+        counts[chunk] = count;
+    });
+
+    int total = 0;
+    for (size_t i = 0; i < counts.size(); i++)
+        total += counts[i];
+    return total;
+}
+
+#endif // TOKENALGORITHMS_H
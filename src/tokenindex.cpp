@@ -0,0 +1,90 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        tokenindex.cpp
+ *
+ * \brief       Defines the methods of the TokenIndex class.
+ */
+#include "tokenindex.h"
+#include "token.h"
+#include "tokenlist.h"
+
+/*!
+ * \brief   Adds a node under its token's type and, for identifiers, its name.
+ * \param tokenNode The node to index.
+ */
+void TokenIndex::add(TokenNode *tokenNode)
+{
+    Token *token = tokenNode->token();
+    std::string type = token->type();
+
+    m_Types[type].insert(tokenNode);
+    if (type == "ID")
+        m_Identifiers[token->lexeme()].insert(tokenNode);
+}
+
+/*!
+ * \brief   Removes a node from the index. Emptied entries are dropped.
+ * \param tokenNode The node to remove. It must still hold the token it was
+ *                  indexed with.
+ */
+void TokenIndex::remove(TokenNode *tokenNode)
+{
+    Token *token = tokenNode->token();
+    std::string type = token->type();
+
+    NodeMap::iterator it = m_Types.find(type);
+    if (it != m_Types.end())
+    {
+        it->second.erase(tokenNode);
+        if (it->second.empty())
+            m_Types.erase(it);
+    }
+
+    if (type != "ID")
+        return;
+
+    it = m_Identifiers.find(token->lexeme());
+    if (it != m_Identifiers.end())
+    {
+        it->second.erase(tokenNode);
+        if (it->second.empty())
+            m_Identifiers.erase(it);
+    }
+}
+
+/*!
+ * \brief   Gets the nodes holding tokens of a type.
+ * \param type  The token type, such as "PREPROCESSOR" or "STRING".
+ * \return  The matching nodes, which may be empty.
+ */
+const TokenIndex::NodeSet& TokenIndex::ofType(const std::string &type) const
+{
+    return lookup(m_Types, type);
+}
+
+/*!
+ * \brief   Gets the nodes holding uses of an identifier.
+ * \param name  The identifier's lexeme.
+ * \return  The matching ID nodes, which may be empty.
+ */
+const TokenIndex::NodeSet& TokenIndex::ofIdentifier(const std::string &name) const
+{
+    return lookup(m_Identifiers, name);
+}
+
+/*!
+ * \brief   Looks up a key without inserting it.
+ * \param map   The map to search.
+ * \param key   The key to find.
+ * \return  The nodes under \p key, or an empty set.
+ */
+const TokenIndex::NodeSet& TokenIndex::lookup(const NodeMap &map,
+                                              const std::string &key)
+{
+    static const NodeSet empty;
+    NodeMap::const_iterator it = map.find(key);
+    return it == map.end() ? empty : it->second;
+}
@@ -0,0 +1,58 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        tokenindex.h
+ *
+ * \brief       Declares the structure of the TokenIndex class.
+ */
+#ifndef TOKENINDEX_H
+#define TOKENINDEX_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+class TokenNode;
+
+/*!
+ * \brief   The TokenIndex class maps token types, and the names of identifier
+ *          tokens, to the nodes of a TokenList holding them.
+ *
+ * A list builds its index on the first query and keeps it current as nodes are
+ * linked and unlinked. Lookups cost the number of hits, not the length of the
+ * list. The nodes of a hit set are in no particular order, and the set must
+ * not be iterated while the list is edited.
+ */
+class TokenIndex
+{
+public:
+    typedef std::unordered_set<TokenNode*> NodeSet;
+
+    /// Adds a node to the index.
+    void add(TokenNode *tokenNode);
+
+    /// Removes a node from the index.
+    void remove(TokenNode *tokenNode);
+
+    /// Returns the nodes whose tokens are of type \p type.
+    const NodeSet &ofType(const std::string &type) const;
+
+    /// Returns the nodes of ID tokens named \p name.
+    const NodeSet &ofIdentifier(const std::string &name) const;
+
+private:
+    typedef std::unordered_map<std::string, NodeSet> NodeMap;
+
+    /// Looks up \p key in \p map, returning an empty set if absent.
+    static const NodeSet &lookup(const NodeMap &map, const std::string &key);
+
+    /// Nodes by token type.
+    NodeMap m_Types;
+
+    /// Nodes of ID tokens by lexeme.
+    NodeMap m_Identifiers;
+};
+
+#endif // TOKENINDEX_H
@@ -8,6 +8,15 @@
  * \brief       Defines the structure of the TokenNode and TokenList classes.
  */
 #include "tokenlist.h"
+#include "token.h"
+#include "tokenindex.h"
+#include <new>
+
+/// The number of nodes in a token list's first slab.
+#define FIRST_SLAB_CAPACITY 16
+
+/// The largest number of nodes in one slab.
+#define MAX_SLAB_CAPACITY   4096
 
 /*!
  * \brief Instantiates a TokenNode object, initializes member variables.
@@ -27,6 +36,15 @@ Token* TokenNode::token() const
     return m_Token;
 }
 
+/*!
+ * \brief Replaces the token contained in the TokenNode.
+ * \param token The token the node will hold. The old token is not deleted.
+ */
+void TokenNode::setToken(Token *token)
+{
+    m_Token = token;
+}
+
 /*!
  * \brief Gets a pointer to the node's previous TokenNode.
  * \return The previous TokenNode in the list. Can be NULL.
@@ -64,11 +82,129 @@ void TokenNode::setNextTokenNode(TokenNode *tokenNode)
 }
 
 
+/*!
+ * \brief Instantiates an empty node pool. No slab is allocated until needed.
+ */
+TokenNodePool::TokenNodePool()
+    :m_pFirstSlab(0), m_pLastSlab(0), m_SlabUsed(0), m_pFreeTokenNode(0)
+{
+}
+
+/*!
+ * \brief Destroys the pool, freeing every slab and the nodes within them.
+ */
+TokenNodePool::~TokenNodePool()
+{
+    Slab *slab = m_pFirstSlab, *nextSlab = 0;
+    while (slab)
+    {
+        nextSlab = slab->m_pNextSlab;
+        ::operator delete(slab);
+        slab = nextSlab;
+    }
+}
+
+/*!
+ * \brief   Gets a node for \p token, reusing a released node if possible.
+ * \param token The token the node will hold.
+ * \return  An unlinked node.
+ */
+TokenNode* TokenNodePool::allocate(Token *token)
+{
+    void *memory = 0;
+
+    if (m_pFreeTokenNode)
+    {
+        memory = m_pFreeTokenNode;
+        m_pFreeTokenNode = m_pFreeTokenNode->nextTokenNode();
+    }
+    else
+    {
+        // Start a new slab, twice the size of the last, when this one is full
+        if (!m_pFirstSlab || m_SlabUsed == m_pFirstSlab->m_Capacity)
+        {
+            int capacity = m_pFirstSlab ? m_pFirstSlab->m_Capacity * 2
+                                        : FIRST_SLAB_CAPACITY;
+            if (capacity > MAX_SLAB_CAPACITY)
+                capacity = MAX_SLAB_CAPACITY;
+
+            Slab *slab = static_cast<Slab*>(
+                ::operator new(sizeof(Slab) + capacity * sizeof(TokenNode)));
+            slab->m_pNextSlab = m_pFirstSlab;
+            slab->m_Capacity = capacity;
+            m_pFirstSlab = slab;
+            if (!m_pLastSlab)
+                m_pLastSlab = slab;
+            m_SlabUsed = 0;
+        }
+
+        memory = reinterpret_cast<TokenNode*>(m_pFirstSlab + 1) + m_SlabUsed++;
+    }
+
+    return new (memory) TokenNode(token);
+}
+
+/*!
+ * \brief   Puts a node on the freelist. The node must come from this pool.
+ * \param tokenNode The unlinked node to release.
+ */
+void TokenNodePool::release(TokenNode *tokenNode)
+{
+    tokenNode->setPrevTokenNode(0);
+    tokenNode->setNextTokenNode(m_pFreeTokenNode);
+    m_pFreeTokenNode = tokenNode;
+}
+
+/*!
+ * \brief   Puts a chain of nodes on the freelist in one step.
+ * \param first The first unlinked node of the chain.
+ * \param last  The last node of the chain. Each node from \p first must reach
+ *              \p last through its next node.
+ */
+void TokenNodePool::release(TokenNode *first, TokenNode *last)
+{
+    last->setNextTokenNode(m_pFreeTokenNode);
+    m_pFreeTokenNode = first;
+}
+
+/*!
+ * \brief   Takes ownership of every slab of \p pool, leaving it empty.
+ * \param pool  The pool to take slabs from.
+ *
+ * Slabs are appended behind this pool's own, so the newest slab here is still
+ * the one nodes are bumped from. The other pool's freelist is only kept when
+ * this pool has none; otherwise its nodes stay unused until the slabs are
+ * freed.
+ */
+void TokenNodePool::adopt(TokenNodePool &pool)
+{
+    if (&pool == this || !pool.m_pFirstSlab)
+        return;
+
+    if (!m_pFirstSlab)
+    {
+        m_pFirstSlab = pool.m_pFirstSlab;
+        m_SlabUsed = pool.m_SlabUsed;
+    }
+    else
+        m_pLastSlab->m_pNextSlab = pool.m_pFirstSlab;
+    m_pLastSlab = pool.m_pLastSlab;
+
+    if (!m_pFreeTokenNode)
+        m_pFreeTokenNode = pool.m_pFreeTokenNode;
+
+    pool.m_pFirstSlab = 0;
+    pool.m_pLastSlab = 0;
+    pool.m_SlabUsed = 0;
+    pool.m_pFreeTokenNode = 0;
+}
+
+
 /*!
  * \brief Instantiates a new token list object, initializing member values.
  */
 TokenList::TokenList()
-    :m_FirstTokenNode(0), m_LastTokenNode(0), m_Length(0)
+    :m_FirstTokenNode(0), m_LastTokenNode(0), m_Length(0), m_pIndex(0)
 {
 }
 
@@ -77,14 +213,11 @@ TokenList::TokenList()
  */
 TokenList::~TokenList()
 {
-    TokenNode *curTokenNode = m_FirstTokenNode;
-    TokenNode *nextTokenNode = 0;
-    while (curTokenNode)
-    {
-        nextTokenNode = curTokenNode->nextTokenNode();
-        delete curTokenNode;
-        curTokenNode = nextTokenNode;
-    }
+    delete m_pIndex;
+
+    // Nodes are freed with the pool's slabs
+    m_FirstTokenNode = 0;
+    m_LastTokenNode = 0;
     m_Length = 0;
 }
 
@@ -100,26 +233,16 @@ int TokenList::length() const
 /*!
  * \brief Adds a token to the list.
  * \param token The token to add to the list.
+ * \return The node holding \p token, or NULL if \p token is NULL.
  */
-void TokenList::add(Token *token)
+TokenNode* TokenList::add(Token *token)
 {
     if (!token)
-        return;
-
-    TokenNode *newTokenNode = new TokenNode(token);
+        return 0;
 
-    if (!m_FirstTokenNode)
-    {
-        m_FirstTokenNode = newTokenNode;
-        m_LastTokenNode = newTokenNode;
-    }
-    else
-    {
-        newTokenNode->setPrevTokenNode(m_LastTokenNode);
-        m_LastTokenNode->setNextTokenNode(newTokenNode);
-        m_LastTokenNode = newTokenNode;
-    }
-    m_Length++;
+    TokenNode *newTokenNode = m_Pool.allocate(token);
+    link(newTokenNode, 0);
+    return newTokenNode;
 }
 
 /*!
@@ -129,49 +252,69 @@ void TokenList::add(Token *token)
  * Moves all tokens from this list into \p destTokenList. Tokens are
  * inserted before the \p before token in \p destTokenList. If \p before is
  * NULL, tokens are appended to the end of destTokenList.
+ *
+ * Finding \p before is linear; use splice() when its node is already known.
  */
 void TokenList::move(TokenList *destTokenList, Token *before)
 {
-    // Ensure destination list and index exist
-    // and that this list contains tokens
-    if (!destTokenList || !before || !m_FirstTokenNode)
+    if (!destTokenList)
         return;
 
     // Ensure before token is in the destination token's list
-    TokenNode *beforeTokenNode = destTokenList->find(before);
-    if (!beforeTokenNode)
+    TokenNode *beforeTokenNode = 0;
+    if (before)
+    {
+        beforeTokenNode = destTokenList->find(before);
+        if (!beforeTokenNode)
+            return;
+    }
+
+    destTokenList->splice(beforeTokenNode, *this);
+}
+
+/*!
+ * \brief Moves the contents of another token list into this one.
+ * \param before        The node to insert before, or NULL to append.
+ * \param srcTokenList  The list whose tokens are moved. It is left empty.
+ *
+ * The nodes themselves change lists, so the splice is constant time. \p before
+ * must be a node of this list.
+ */
+void TokenList::splice(TokenNode *before, TokenList &srcTokenList)
+{
+    if (&srcTokenList == this || !srcTokenList.m_FirstTokenNode)
         return;
 
-    // Insert at tail of the list
+    TokenNode *first = srcTokenList.m_FirstTokenNode,
+              *last = srcTokenList.m_LastTokenNode;
+    TokenNode *prevTokenNode = before ? before->prevTokenNode() : m_LastTokenNode;
+
+    first->setPrevTokenNode(prevTokenNode);
+    last->setNextTokenNode(before);
+
+    // Spliced nodes begin the list
+    if (!prevTokenNode)
+        m_FirstTokenNode = first;
+    else
+        prevTokenNode->setNextTokenNode(first);
+
+    // Spliced nodes end the list
     if (!before)
-    {
-        // If destination list is empty, simply set first/last token nodes
-        if (!destTokenList->m_FirstTokenNode)
-        {
-            destTokenList->m_FirstTokenNode = m_FirstTokenNode;
-            destTokenList->m_LastTokenNode = m_LastTokenNode;
-        }
-        else
-            destTokenList->m_LastTokenNode->setNextTokenNode(m_FirstTokenNode);
-    }
+        m_LastTokenNode = last;
     else
-    {
-        TokenNode *prevTokenNode = beforeTokenNode->prevTokenNode();
-
-        // Found node is head token
-        if (!prevTokenNode)
-            destTokenList->m_FirstTokenNode = m_FirstTokenNode;
-        else
-            prevTokenNode->setNextTokenNode(m_FirstTokenNode);
-        m_LastTokenNode->setNextTokenNode(beforeTokenNode);
-        beforeTokenNode->setPrevTokenNode(m_LastTokenNode);
-    }
+        before->setPrevTokenNode(last);
 
-    // Transfer ownership of tokens to destination
-    m_FirstTokenNode = 0;
-    m_LastTokenNode = 0;
+    m_Length += srcTokenList.m_Length;
+
+    // Rather than index every spliced node, rebuild on the next query
+    invalidateIndex();
+    srcTokenList.invalidateIndex();
 
-    destTokenList->m_Length += m_Length;
+    // Transfer ownership of tokens, and the slabs holding them, to destination
+    m_Pool.adopt(srcTokenList.m_Pool);
+    srcTokenList.m_FirstTokenNode = 0;
+    srcTokenList.m_LastTokenNode = 0;
+    srcTokenList.m_Length = 0;
 }
 
 /*!
@@ -186,25 +329,78 @@ void TokenList::remove(Token *token)
     TokenNode *tokenNode = find(token);
 
     if (tokenNode)// Token found, remove it
+        remove(tokenNode);
+}
+
+/*!
+ * \brief Removes a token node from the list in constant time.
+ * \param tokenNode The node to remove. It must belong to this list and is
+ *                  invalid afterwards. Its token is not deleted.
+ */
+void TokenList::remove(TokenNode *tokenNode)
+{
+    if (!tokenNode)
+        return;
+
+    unlink(tokenNode);
+    m_Pool.release(tokenNode);
+}
+
+/*!
+ * \brief   Removes a range of tokens from the list and deletes them.
+ * \param first The first node to remove. It must belong to this list.
+ * \param last  The node after the last one to remove, or NULL to remove to the
+ *              end of the list. It must be \p first or follow it.
+ * \return  The number of tokens removed.
+ *
+ * The whole span is unlinked with one splice and its nodes go back to the pool
+ * as a single chain; only the tokens are visited, to delete them.
+ */
+int TokenList::erase(TokenNode *first, TokenNode *last)
+{
+    if (!first || first == last)
+        return 0;
+
+    TokenNode *prevTokenNode = first->prevTokenNode();
+    TokenNode *lastErased = last ? last->prevTokenNode() : m_LastTokenNode;
+
+    // Close the gap around the span
+    if (!prevTokenNode)
+        m_FirstTokenNode = last;
+    else
+        prevTokenNode->setNextTokenNode(last);
+
+    if (!last)
+        m_LastTokenNode = prevTokenNode;
+    else
+        last->setPrevTokenNode(prevTokenNode);
+
+    int count = 0;
+    for (TokenNode *tokenNode = first; tokenNode != last;
+         tokenNode = tokenNode->nextTokenNode())
     {
-        TokenNode *prevTokenNode = tokenNode->prevTokenNode(),
-                  *nextTokenNode = tokenNode->nextTokenNode();
-
-        // Found node is head token
-        if (!prevTokenNode)
-            m_FirstTokenNode = nextTokenNode;
-        else
-            prevTokenNode->setNextTokenNode(nextTokenNode);
-
-        // Found node is tail token
-        if (!nextTokenNode)
-            m_LastTokenNode = prevTokenNode;
-        else
-            nextTokenNode->setPrevTokenNode(prevTokenNode);
-
-        delete tokenNode;
+        if (m_pIndex)
+            m_pIndex->remove(tokenNode);
+        delete tokenNode->token();
+        count++;
     }
-    m_Length--;
+
+    m_Pool.release(first, lastErased);
+    m_Length -= count;
+    return count;
+}
+
+/*!
+ * \brief   Removes the tokens in [\p first, \p last) from the list and deletes
+ *          them.
+ * \param first The first token to remove.
+ * \param last  The position after the last token to remove.
+ * \return  An iterator at \p last.
+ */
+TokenList::iterator TokenList::erase(iterator first, iterator last)
+{
+    erase(first.node(), last.node());
+    return last;
 }
 
 /*!
@@ -217,21 +413,26 @@ void TokenList::insertAfter(Token *token, Token *after)
     if (!token || !after)
         return;
 
-    TokenNode *newTokenNode = new TokenNode(token);
     TokenNode *afterNode = find(after);
 
     if (afterNode)
-    {
-        TokenNode *nextTokenNode = afterNode->nextTokenNode();
-        if (nextTokenNode)
-        {
-            nextTokenNode->setPrevTokenNode(newTokenNode);
-            newTokenNode->setNextTokenNode(nextTokenNode);
-        }
-        newTokenNode->setPrevTokenNode(afterNode);
-        afterNode->setNextTokenNode(newTokenNode);
-    }
-    m_Length++;
+        insertAfter(token, afterNode);
+}
+
+/*!
+ * \brief Inserts a new token in the list after the given node.
+ * \param token     The token to insert in the list.
+ * \param after     The node to insert after. It must belong to this list.
+ * \return The node holding \p token, or NULL if nothing was inserted.
+ */
+TokenNode* TokenList::insertAfter(Token *token, TokenNode *after)
+{
+    if (!token || !after)
+        return 0;
+
+    TokenNode *newTokenNode = m_Pool.allocate(token);
+    link(newTokenNode, after->nextTokenNode());
+    return newTokenNode;
 }
 
 /*!
@@ -244,21 +445,27 @@ void TokenList::insertBefore(Token *token, Token *before)
     if (!token || !before)
         return;
 
-    TokenNode *newTokenNode = new TokenNode(token);
     TokenNode *beforeNode = find(before);
 
     if (beforeNode)
-    {
-        TokenNode *prevTokenNode = beforeNode->prevTokenNode();
-        if (prevTokenNode)
-        {
-            prevTokenNode->setNextTokenNode(newTokenNode);
-            newTokenNode->setPrevTokenNode(prevTokenNode);
-        }
-        newTokenNode->setNextTokenNode(beforeNode);
-        beforeNode->setPrevTokenNode(newTokenNode);
-    }
-    m_Length++;
+        insertBefore(token, beforeNode);
+}
+
+/*!
+ * \brief Inserts a new token in the list before the given node.
+ * \param token     The token to insert in the list.
+ * \param before    The node to insert before, or NULL to append. It must
+ *                  belong to this list.
+ * \return The node holding \p token, or NULL if nothing was inserted.
+ */
+TokenNode* TokenList::insertBefore(Token *token, TokenNode *before)
+{
+    if (!token)
+        return 0;
+
+    TokenNode *newTokenNode = m_Pool.allocate(token);
+    link(newTokenNode, before);
+    return newTokenNode;
 }
 
 /*!
@@ -268,7 +475,7 @@ void TokenList::insertBefore(Token *token, Token *before)
  */
 Token* TokenList::operator[](int index)
 {
-    if (index < 0 || index > m_Length)
+    if (index < 0 || index >= m_Length)
         return 0;
 
     TokenNode *tokenNode = m_FirstTokenNode;
@@ -289,3 +496,245 @@ TokenNode* TokenList::find(Token *token)
         curTokenNode = curTokenNode->nextTokenNode();
     return curTokenNode;
 }
+
+
+/*!
+ * \brief   Gets an iterator to the first token in the list.
+ * \return  An iterator at the head of the list, or end() if empty.
+ */
+TokenList::iterator TokenList::begin()
+{
+    return iterator(this, m_FirstTokenNode);
+}
+
+/*!
+ * \brief   Gets an iterator past the last token in the list.
+ * \return  An iterator at the end of the list.
+ */
+TokenList::iterator TokenList::end()
+{
+    return iterator(this, 0);
+}
+
+/// Gets a constant iterator to the first token in the list.
+TokenList::const_iterator TokenList::begin() const
+{
+    return const_iterator(this, m_FirstTokenNode);
+}
+
+/// Gets a constant iterator past the last token in the list.
+TokenList::const_iterator TokenList::end() const
+{
+    return const_iterator(this, 0);
+}
+
+/*!
+ * \brief   Gets the index of the list's tokens, building it if needed.
+ * \return  The index, which the list keeps current until it is invalidated.
+ *
+ * The first query costs a pass over the list. After that, linking and
+ * unlinking nodes update the index as they go. Splices invalidate it, since
+ * indexing the spliced nodes would cost as much as rebuilding later.
+ */
+const TokenIndex& TokenList::index()
+{
+    if (!m_pIndex)
+    {
+        m_pIndex = new TokenIndex;
+        for (TokenNode *tokenNode = m_FirstTokenNode; tokenNode;
+             tokenNode = tokenNode->nextTokenNode())
+            m_pIndex->add(tokenNode);
+    }
+    return *m_pIndex;
+}
+
+/*!
+ * \brief   Discards the index; the next query rebuilds it.
+ *
+ * Must be called after replacing tokens through TokenNode::setToken(), which
+ * the list cannot see.
+ */
+void TokenList::invalidateIndex()
+{
+    delete m_pIndex;
+    m_pIndex = 0;
+}
+
+/*!
+ * \brief   Links a node into the list.
+ * \param tokenNode The node to link. It must not belong to any list.
+ * \param before    The node to link before, or NULL to append to the list.
+ */
+void TokenList::link(TokenNode *tokenNode, TokenNode *before)
+{
+    TokenNode *prevTokenNode = before ? before->prevTokenNode() : m_LastTokenNode;
+
+    tokenNode->setPrevTokenNode(prevTokenNode);
+    tokenNode->setNextTokenNode(before);
+
+    // Linked node is the new head token
+    if (!prevTokenNode)
+        m_FirstTokenNode = tokenNode;
+    else
+        prevTokenNode->setNextTokenNode(tokenNode);
+
+    // Linked node is the new tail token
+    if (!before)
+        m_LastTokenNode = tokenNode;
+    else
+        before->setPrevTokenNode(tokenNode);
+
+    if (m_pIndex)
+        m_pIndex->add(tokenNode);
+    m_Length++;
+}
+
+/*!
+ * \brief   Unlinks a node from the list. The node is not freed.
+ * \param tokenNode The node to unlink. It must belong to this list.
+ */
+void TokenList::unlink(TokenNode *tokenNode)
+{
+    TokenNode *prevTokenNode = tokenNode->prevTokenNode(),
+              *nextTokenNode = tokenNode->nextTokenNode();
+
+    // Node is head token
+    if (!prevTokenNode)
+        m_FirstTokenNode = nextTokenNode;
+    else
+        prevTokenNode->setNextTokenNode(nextTokenNode);
+
+    // Node is tail token
+    if (!nextTokenNode)
+        m_LastTokenNode = prevTokenNode;
+    else
+        nextTokenNode->setPrevTokenNode(prevTokenNode);
+
+    tokenNode->setPrevTokenNode(0);
+    tokenNode->setNextTokenNode(0);
+
+    if (m_pIndex)
+        m_pIndex->remove(tokenNode);
+    m_Length--;
+}
+
+
+/*!
+ * \brief Instantiates a cursor at the first token of \p tokens.
+ * \param tokens    The token list to edit.
+ */
+TokenCursor::TokenCursor(TokenList &tokens)
+    :m_Tokens(tokens), m_TokenNode(tokens.m_FirstTokenNode)
+{
+}
+
+/*!
+ * \brief Instantiates a cursor at a known node of \p tokens.
+ * \param tokens    The token list to edit.
+ * \param tokenNode A node of \p tokens, or NULL for the end of the list.
+ */
+TokenCursor::TokenCursor(TokenList &tokens, TokenNode *tokenNode)
+    :m_Tokens(tokens), m_TokenNode(tokenNode)
+{
+}
+
+/*!
+ * \brief Gets whether the cursor has passed the last token.
+ * \return true if there is no token at the cursor; otherwise false.
+ */
+bool TokenCursor::atEnd() const
+{
+    return m_TokenNode == 0;
+}
+
+/*!
+ * \brief Gets the token at the cursor.
+ * \return The token at the cursor, or NULL if at the end of the list.
+ */
+Token* TokenCursor::token() const
+{
+    return m_TokenNode ? m_TokenNode->token() : 0;
+}
+
+/*!
+ * \brief Gets the node at the cursor, for use with the TokenList node API.
+ * \return The node at the cursor, or NULL if at the end of the list.
+ */
+TokenNode* TokenCursor::node() const
+{
+    return m_TokenNode;
+}
+
+/*!
+ * \brief Advances the cursor to the next token. Does nothing at the end.
+ */
+void TokenCursor::next()
+{
+    if (m_TokenNode)
+        m_TokenNode = m_TokenNode->nextTokenNode();
+}
+
+/*!
+ * \brief Moves the cursor to the previous token. From the end, moves to the
+ *        last token.
+ */
+void TokenCursor::prev()
+{
+    m_TokenNode = m_TokenNode ? m_TokenNode->prevTokenNode()
+                              : m_Tokens.m_LastTokenNode;
+}
+
+/*!
+ * \brief   Removes the token at the cursor from the list.
+ * \return  The removed token, which the caller now owns, or NULL at the end.
+ *
+ * The cursor is left at the token which followed the removed token.
+ */
+Token* TokenCursor::erase()
+{
+    if (!m_TokenNode)
+        return 0;
+
+    TokenNode *tokenNode = m_TokenNode;
+    Token *token = tokenNode->token();
+    m_TokenNode = tokenNode->nextTokenNode();
+
+    m_Tokens.remove(tokenNode);
+    return token;
+}
+
+/*!
+ * \brief   Removes and deletes every token from the cursor up to \p last.
+ * \param last  The node to stop at, or NULL to erase to the end of the list.
+ *              It must be at or after the cursor.
+ * \return  The number of tokens erased.
+ *
+ * The cursor is left at \p last.
+ */
+int TokenCursor::eraseUntil(TokenNode *last)
+{
+    int count = m_Tokens.erase(m_TokenNode, last);
+    m_TokenNode = last;
+    return count;
+}
+
+/*!
+ * \brief Inserts a token before the cursor. At the end, appends the token.
+ * \param token The token to insert.
+ */
+void TokenCursor::insertBefore(Token *token)
+{
+    m_Tokens.insertBefore(token, m_TokenNode);
+}
+
+/*!
+ * \brief Inserts a token after the cursor. At the end, does nothing.
+ * \param token The token to insert.
+ */
+void TokenCursor::insertAfter(Token *token)
+{
+    if (!m_TokenNode)
+        return;
+
+    m_Tokens.insertAfter(token, m_TokenNode);
+}
@@ -10,7 +10,11 @@
 #ifndef TOKENLIST_H
 #define TOKENLIST_H
 
+#include <cstddef>
+#include <iterator>
+
 class Token;
+class TokenIndex;
 
 /*!
  * \brief   The TokenNode class can be entered into a token list. It contains a
@@ -22,6 +26,7 @@ class TokenNode
 public:
     TokenNode(Token *token);
     Token *token() const;
+    void setToken(Token *token);
     TokenNode* prevTokenNode() const;
     void setPrevTokenNode(TokenNode *tokenNode);
     TokenNode* nextTokenNode() const;
@@ -38,38 +43,137 @@ private:
     TokenNode *m_NextTokenNode;
 };
 
+/*!
+ * \brief   The TokenNodePool class hands out token nodes from slabs of
+ *          contiguous memory. It is an implementation detail of TokenList.
+ *
+ * Released nodes go on a freelist and are reused before the current slab is
+ * bumped. Slabs grow geometrically and are only freed, all at once, when the
+ * pool is destroyed.
+ */
+class TokenNodePool
+{
+public:
+    TokenNodePool();
+    ~TokenNodePool();
+
+    /// Gets an unlinked node holding \p token.
+    TokenNode *allocate(Token *token);
+
+    /// Returns a node to the pool for reuse.
+    void release(TokenNode *tokenNode);
+
+    /// Returns a chain of nodes, linked first to last, to the pool for reuse.
+    void release(TokenNode *first, TokenNode *last);
+
+    /// Takes ownership of every slab of another pool.
+    void adopt(TokenNodePool &pool);
+
+private:
+    /// Header of a slab; its nodes follow it in memory.
+    struct Slab
+    {
+        /// The next (older) slab in the pool.
+        Slab *m_pNextSlab;
+
+        /// The number of nodes the slab holds.
+        int m_Capacity;
+    };
+
+    // Pools own raw memory and are not copyable
+    TokenNodePool(const TokenNodePool&);
+    TokenNodePool& operator=(const TokenNodePool&);
+
+    /// The newest slab, which nodes are bumped from.
+    Slab *m_pFirstSlab;
+
+    /// The oldest slab, so that another pool's slabs can be appended.
+    Slab *m_pLastSlab;
+
+    /// The number of nodes handed out from the newest slab.
+    int m_SlabUsed;
+
+    /// The first released node; released nodes chain through their next node.
+    TokenNode *m_pFreeTokenNode;
+};
+
 /*!
  * \brief A self-cleaning list of Tokens.
  */
 class TokenList
 {
 public:
+    class iterator;
+    class const_iterator;
+
     TokenList();
     ~TokenList();
 
     /// Returns the length of the list of tokens.
     int length() const;
 
-    /// Adds a token to the list.
-    void add(Token *token);
+    /// Adds a token to the list, returning its node.
+    TokenNode *add(Token *token);
 
     /// Moves the entire contents of this list into another.
     void move(TokenList *destTokenList, Token *before=0);
 
+    /// Moves the entire contents of another list into this one.
+    void splice(TokenNode *before, TokenList &srcTokenList);
+
     /// Removes a token from the list.
     void remove(Token *token);
 
+    /// Removes a token node from the list.
+    void remove(TokenNode *tokenNode);
+
+    /// Removes and deletes the tokens from \p first up to, not including, \p last.
+    int erase(TokenNode *first, TokenNode *last);
+
     /// Inserts a token in the list after the given token.
     void insertAfter(Token *token, Token *after);
 
+    /// Inserts a token in the list after the given token node.
+    TokenNode *insertAfter(Token *token, TokenNode *after);
+
     /// Inserts a token in the list before the given token.
     void insertBefore(Token *token, Token *before);
+
+    /// Inserts a token in the list before the given token node.
+    TokenNode *insertBefore(Token *token, TokenNode *before);
     Token* operator[](int index);
 
+    /// Removes and deletes the tokens in [\p first, \p last).
+    iterator erase(iterator first, iterator last);
+
+    /// Returns the list's index of tokens by type and identifier.
+    const TokenIndex &index();
+
+    /// Discards the index after tokens are replaced behind the list's back.
+    void invalidateIndex();
+
+    /// Iterators over the tokens of the list, in order.
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
 private:
+    friend class TokenCursor;
+
+    // Lists own their nodes and are not copyable
+    TokenList(const TokenList&);
+    TokenList& operator=(const TokenList&);
+
     /// Find a token node in the list.
     TokenNode* find(Token *token);
 
+    /// Links an unlisted node into the list before \p before, or at the tail.
+    void link(TokenNode *tokenNode, TokenNode *before);
+
+    /// Unlinks a node from the list without freeing it.
+    void unlink(TokenNode *tokenNode);
+
     /// The first token in the list.
     TokenNode *m_FirstTokenNode;
 
@@ -78,7 +182,184 @@ private:
 
     /// The length of the list.
     int m_Length;
+
+    /// The slabs the list's nodes are allocated from.
+    TokenNodePool m_Pool;
+
+    /// The index of the list's tokens, or NULL until it is first queried.
+    TokenIndex *m_pIndex;
+
+public:
+    /*!
+     * \brief   The iterator class walks a token list in either direction. It
+     *          may be used with the standard library algorithms.
+     *
+     * Dereferencing yields the Token pointer held by the current node. The end
+     * iterator holds a NULL node; decrementing it yields the last token.
+     */
+    class iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Token* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Token** pointer;
+        typedef Token* reference;
+
+        iterator() :m_List(0), m_Node(0) {}
+        iterator(const TokenList *list, TokenNode *node)
+            :m_List(list), m_Node(node) {}
+
+        Token* operator*() const { return m_Node->token(); }
+
+        /// The node handle at the iterator, or NULL at the end.
+        TokenNode *node() const { return m_Node; }
+
+        iterator& operator++()
+        {
+            m_Node = m_Node->nextTokenNode();
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+        iterator& operator--()
+        {
+            m_Node = m_Node ? m_Node->prevTokenNode() : m_List->m_LastTokenNode;
+            return *this;
+        }
+        iterator operator--(int)
+        {
+            iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const iterator &b) const { return m_Node == b.m_Node; }
+        bool operator!=(const iterator &b) const { return m_Node != b.m_Node; }
+
+    private:
+        friend class const_iterator;
+
+        /// The list being iterated, used to step back from the end.
+        const TokenList *m_List;
+
+        /// The current node, or NULL at the end of the list.
+        TokenNode *m_Node;
+    };
+
+    /*!
+     * \brief   The const_iterator class walks a constant token list in either
+     *          direction.
+     */
+    class const_iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Token* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Token* const* pointer;
+        typedef Token* reference;
+
+        const_iterator() :m_List(0), m_Node(0) {}
+        const_iterator(const TokenList *list, const TokenNode *node)
+            :m_List(list), m_Node(node) {}
+        const_iterator(const iterator &it)
+            :m_List(it.m_List), m_Node(it.m_Node) {}
+
+        Token* operator*() const { return m_Node->token(); }
+
+        /// The node handle at the iterator, or NULL at the end.
+        const TokenNode *node() const { return m_Node; }
+
+        const_iterator& operator++()
+        {
+            m_Node = m_Node->nextTokenNode();
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+        const_iterator& operator--()
+        {
+            m_Node = m_Node ? m_Node->prevTokenNode() : m_List->m_LastTokenNode;
+            return *this;
+        }
+        const_iterator operator--(int)
+        {
+            const_iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator &b) const { return m_Node == b.m_Node; }
+        bool operator!=(const const_iterator &b) const { return m_Node != b.m_Node; }
+
+    private:
+        /// The list being iterated, used to step back from the end.
+        const TokenList *m_List;
+
+        /// The current node, or NULL at the end of the list.
+        const TokenNode *m_Node;
+    };
 };
 
+/*!
+ * \brief   The TokenCursor class is a mutable position within a token list.
+ *
+ * Unlike an iterator, a cursor may edit the list around its position. Erasing
+ * at the cursor and inserting on either side of it are constant time. A cursor
+ * positioned past the last token is at the end; inserting before the end
+ * appends to the list.
+ */
+class TokenCursor
+{
+public:
+    /// Creates a cursor positioned at the first token of \p tokens.
+    TokenCursor(TokenList &tokens);
+
+    /// Creates a cursor positioned at \p tokenNode within \p tokens.
+    TokenCursor(TokenList &tokens, TokenNode *tokenNode);
+
+    /// Returns whether the cursor is past the last token.
+    bool atEnd() const;
+
+    /// Returns the token at the cursor, or NULL at the end.
+    Token *token() const;
+
+    /// Returns the node handle at the cursor, or NULL at the end.
+    TokenNode *node() const;
+
+    /// Moves the cursor to the next token.
+    void next();
+
+    /// Moves the cursor to the previous token.
+    void prev();
+
+    /// Removes the token at the cursor and moves to the next token.
+    Token *erase();
+
+    /// Removes and deletes tokens from the cursor up to \p last.
+    int eraseUntil(TokenNode *last);
+
+    /// Inserts a token before the cursor.
+    void insertBefore(Token *token);
+
+    /// Inserts a token after the cursor.
+    void insertAfter(Token *token);
+
+private:
+    /// The list being edited.
+    TokenList &m_Tokens;
+
+    /// The node at the cursor, or NULL at the end.
+    TokenNode *m_TokenNode;
+};
 
 #endif // TOKENLIST_H
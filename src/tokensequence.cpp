@@ -0,0 +1,322 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        tokensequence.cpp
+ *
+ * \brief       Defines the methods of the TokenBuffer and TokenSequence
+ *              classes.
+ */
+#include "tokensequence.h"
+#include "token.h"
+#include "tokenlist.h"
+
+/*!
+ * \brief   Instantiates a buffer holding the tokens of \p tokens.
+ * \param tokens    The tokens to take. The list is left empty, and the buffer
+ *                  becomes responsible for deleting the tokens.
+ *
+ * The buffer starts with one reference, held by the caller.
+ */
+TokenBuffer::TokenBuffer(TokenList &tokens)
+    :m_RefCount(1)
+{
+    m_Tokens.reserve(tokens.length());
+
+    TokenCursor cursor(tokens);
+    while (!cursor.atEnd())
+        m_Tokens.push_back(cursor.erase());
+}
+
+/*!
+ * \brief   Destroys the buffer and its tokens.
+ */
+TokenBuffer::~TokenBuffer()
+{
+    for (size_t i = 0; i < m_Tokens.size(); i++)
+        delete m_Tokens[i];
+}
+
+/*!
+ * \brief   Gets the number of tokens in the buffer.
+ * \return  The length of the buffer.
+ */
+int TokenBuffer::length() const
+{
+    return (int)m_Tokens.size();
+}
+
+/*!
+ * \brief   Gets a token of the buffer.
+ * \param index The index of the token, which must be within the buffer.
+ * \return  The token at \p index.
+ */
+Token* TokenBuffer::token(int index) const
+{
+    return m_Tokens[index];
+}
+
+/// Adds a reference to the buffer.
+void TokenBuffer::addRef()
+{
+    m_RefCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*!
+ * \brief   Drops a reference to the buffer. The buffer and its tokens are
+ *          deleted when no references remain.
+ */
+void TokenBuffer::release()
+{
+    if (m_RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete this;
+}
+
+
+/*!
+ * \brief   Instantiates an empty token sequence.
+ */
+TokenSequence::TokenSequence()
+    :m_Length(0)
+{
+}
+
+/*!
+ * \brief   Instantiates a sequence with the same pieces as \p sequence. Only
+ *          the piece list is copied; the buffers are shared.
+ * \param sequence  The sequence to copy.
+ */
+TokenSequence::TokenSequence(const TokenSequence &sequence)
+    :m_Pieces(sequence.m_Pieces), m_Length(sequence.m_Length)
+{
+    for (PieceList::iterator it = m_Pieces.begin(); it != m_Pieces.end(); ++it)
+        it->m_pBuffer->addRef();
+}
+
+/*!
+ * \brief   Destroys the sequence, releasing the buffers of its pieces.
+ */
+TokenSequence::~TokenSequence()
+{
+    for (PieceList::iterator it = m_Pieces.begin(); it != m_Pieces.end(); ++it)
+        it->m_pBuffer->release();
+}
+
+/*!
+ * \brief   Replaces the pieces of this sequence with those of \p sequence.
+ * \param sequence  The sequence to copy.
+ * \return  This sequence.
+ */
+TokenSequence& TokenSequence::operator=(const TokenSequence &sequence)
+{
+    if (&sequence != this)
+    {
+        TokenSequence copy(sequence);
+        m_Pieces.swap(copy.m_Pieces);
+        m_Length = copy.m_Length;
+    }
+    return *this;
+}
+
+/*!
+ * \brief   Gets the number of tokens in the sequence.
+ * \return  The length of the sequence.
+ */
+int TokenSequence::length() const
+{
+    return m_Length;
+}
+
+/*!
+ * \brief   Gets the number of pieces the sequence is made of.
+ * \return  The number of pieces.
+ */
+int TokenSequence::pieceCount() const
+{
+    return (int)m_Pieces.size();
+}
+
+/*!
+ * \brief   Appends the tokens of \p buffer to the sequence.
+ * \param buffer    The buffer to append. The sequence adds a reference.
+ */
+void TokenSequence::append(TokenBuffer *buffer)
+{
+    insert(end(), buffer);
+}
+
+/*!
+ * \brief   Appends a run of tokens of another sequence, sharing its buffers.
+ * \param first The first token of the run.
+ * \param last  The position past the last token of the run, in the same
+ *              sequence as \p first, which must not be this sequence.
+ *
+ * Costs one piece per piece the run spans, not one per token.
+ */
+void TokenSequence::append(iterator first, iterator last)
+{
+    while (first != last)
+    {
+        Piece piece = *first.m_Piece;
+        piece.m_Start += first.m_Offset;
+        piece.m_Length -= first.m_Offset;
+
+        bool lastPiece = first.m_Piece == last.m_Piece;
+        if (lastPiece)
+            piece.m_Length = last.m_Offset - first.m_Offset;
+
+        piece.m_pBuffer->addRef();
+        m_Pieces.push_back(piece);
+        m_Length += piece.m_Length;
+
+        if (lastPiece)
+            break;
+        first = iterator(++first.m_Piece, 0);
+    }
+}
+
+/*!
+ * \brief   Inserts the tokens of \p buffer into the sequence.
+ * \param pos       The position to insert before.
+ * \param buffer    The buffer to insert. The sequence adds a reference.
+ * \return  An iterator at the first inserted token, or \p pos if \p buffer is
+ *          empty.
+ *
+ * At most one piece is split, so the insertion is constant time regardless of
+ * the size of either the sequence or the buffer.
+ */
+TokenSequence::iterator TokenSequence::insert(iterator pos, TokenBuffer *buffer)
+{
+    if (!buffer || !buffer->length())
+        return pos;
+
+    Piece piece;
+    piece.m_pBuffer = buffer;
+    piece.m_Start = 0;
+    piece.m_Length = buffer->length();
+
+    buffer->addRef();
+    m_Length += piece.m_Length;
+    return iterator(m_Pieces.insert(split(pos), piece), 0);
+}
+
+/*!
+ * \brief   Inserts the tokens of \p sequence into this sequence.
+ * \param pos       The position to insert before.
+ * \param sequence  The sequence whose pieces are inserted. It is unchanged.
+ * \return  An iterator at the first inserted token, or \p pos if \p sequence
+ *          is empty.
+ *
+ * Costs one piece per piece of \p sequence, not one per token.
+ */
+TokenSequence::iterator TokenSequence::insert(iterator pos,
+                                              const TokenSequence &sequence)
+{
+    if (!sequence.m_Length)
+        return pos;
+
+    // Copy first, in case sequence is this sequence
+    PieceList pieces(sequence.m_Pieces);
+    for (PieceList::iterator it = pieces.begin(); it != pieces.end(); ++it)
+        it->m_pBuffer->addRef();
+
+    PieceList::iterator before = split(pos);
+    PieceList::iterator first = pieces.begin();
+    m_Length += sequence.m_Length;
+    m_Pieces.splice(before, pieces);
+    return iterator(first, 0);
+}
+
+/*!
+ * \brief   Removes one token from the sequence. The token is not deleted.
+ * \param pos   The position of the token to remove.
+ * \return  An iterator at the token which followed the removed token.
+ */
+TokenSequence::iterator TokenSequence::erase(iterator pos)
+{
+    PieceList::iterator piece = pos.m_Piece;
+    PieceList::iterator next = piece;
+    ++next;
+    m_Length--;
+
+    // Drop the piece entirely
+    if (piece->m_Length == 1)
+    {
+        piece->m_pBuffer->release();
+        m_Pieces.erase(piece);
+        return iterator(next, 0);
+    }
+
+    // Trim the front of the piece
+    if (pos.m_Offset == 0)
+    {
+        piece->m_Start++;
+        piece->m_Length--;
+        return iterator(piece, 0);
+    }
+
+    // Trim the back of the piece
+    if (pos.m_Offset == piece->m_Length - 1)
+    {
+        piece->m_Length--;
+        return iterator(next, 0);
+    }
+
+    // Split the piece around the token
+    Piece tail = *piece;
+    tail.m_Start += pos.m_Offset + 1;
+    tail.m_Length -= pos.m_Offset + 1;
+    piece->m_Length = pos.m_Offset;
+    tail.m_pBuffer->addRef();
+    return iterator(m_Pieces.insert(next, tail), 0);
+}
+
+/*!
+ * \brief   Appends a copy of every token of the sequence to a token list.
+ * \param tokens    The list to append to. It owns the copies.
+ */
+void TokenSequence::copyTo(TokenList &tokens) const
+{
+    for (PieceList::const_iterator it = m_Pieces.begin(); it != m_Pieces.end(); ++it)
+        for (int i = 0; i < it->m_Length; i++)
+            tokens.add(new Token(*it->m_pBuffer->token(it->m_Start + i)));
+}
+
+/*!
+ * \brief   Gets an iterator at the first token of the sequence.
+ * \return  The first position, or end() if the sequence is empty.
+ */
+TokenSequence::iterator TokenSequence::begin()
+{
+    return iterator(m_Pieces.begin(), 0);
+}
+
+/*!
+ * \brief   Gets an iterator past the last token of the sequence.
+ * \return  The end position.
+ */
+TokenSequence::iterator TokenSequence::end()
+{
+    return iterator(m_Pieces.end(), 0);
+}
+
+/*!
+ * \brief   Splits the piece at \p pos in two, unless \p pos already begins one.
+ * \param pos   The position to split at.
+ * \return  The piece which begins at \p pos, or the end of the piece list.
+ */
+TokenSequence::PieceList::iterator TokenSequence::split(iterator pos)
+{
+    if (pos.m_Offset == 0)
+        return pos.m_Piece;
+
+    Piece tail = *pos.m_Piece;
+    tail.m_Start += pos.m_Offset;
+    tail.m_Length -= pos.m_Offset;
+    pos.m_Piece->m_Length = pos.m_Offset;
+    tail.m_pBuffer->addRef();
+
+    PieceList::iterator next = pos.m_Piece;
+    return m_Pieces.insert(++next, tail);
+}
@@ -0,0 +1,210 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        tokensequence.h
+ *
+ * \brief       Declares the structure of the TokenBuffer and TokenSequence
+ *              classes.
+ */
+#ifndef TOKENSEQUENCE_H
+#define TOKENSEQUENCE_H
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <vector>
+
+class Token;
+class TokenList;
+
+/*!
+ * \brief   The TokenBuffer class is an immutable array of the tokens lexed from
+ *          one file. It is shared by reference count between the sequences
+ *          which refer to it, and deletes its tokens when the last lets go.
+ *
+ * References may be added and dropped from several threads at once.
+ */
+class TokenBuffer
+{
+public:
+    /// Creates a buffer from the tokens of \p tokens, leaving it empty.
+    TokenBuffer(TokenList &tokens);
+
+    /// Returns the number of tokens in the buffer.
+    int length() const;
+
+    /// Returns the token at \p index.
+    Token *token(int index) const;
+
+    /// Adds a reference to the buffer.
+    void addRef();
+
+    /// Drops a reference to the buffer, deleting it after the last.
+    void release();
+
+private:
+    /// Buffers are deleted through release().
+    ~TokenBuffer();
+
+    // Buffers are shared, never copied
+    TokenBuffer(const TokenBuffer&);
+    TokenBuffer& operator=(const TokenBuffer&);
+
+    /// The tokens, in file order.
+    std::vector<Token*> m_Tokens;
+
+    /// The number of sequences, pieces or other owners sharing the buffer.
+    std::atomic<int> m_RefCount;
+};
+
+/*!
+ * \brief   The TokenSequence class is a piece table of tokens.
+ *
+ * A sequence is a list of pieces, each a run of consecutive tokens in a
+ * TokenBuffer. Inserting a whole buffer, such as an included file, adds a
+ * piece (splitting at most one other) without touching any token, and
+ * iteration walks each piece as a plain array.
+ *
+ * Tokens belong to their buffers; a sequence never deletes or modifies them.
+ */
+class TokenSequence
+{
+private:
+    /// A run of \p m_Length tokens of \p m_pBuffer starting at \p m_Start.
+    struct Piece
+    {
+        TokenBuffer *m_pBuffer;
+        int m_Start;
+        int m_Length;
+    };
+
+    typedef std::list<Piece> PieceList;
+
+public:
+    /*!
+     * \brief   The iterator class walks the tokens of a sequence in order.
+     *
+     * Inserting or erasing may split the piece at the edit, which invalidates
+     * iterators into that piece; iterators into other pieces remain valid.
+     */
+    class iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Token* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Token* const* pointer;
+        typedef Token* reference;
+
+        iterator() :m_Offset(0) {}
+
+        Token* operator*() const
+        {
+            return m_Piece->m_pBuffer->token(m_Piece->m_Start + m_Offset);
+        }
+
+        iterator& operator++()
+        {
+            if (++m_Offset == m_Piece->m_Length)
+            {
+                ++m_Piece;
+                m_Offset = 0;
+            }
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+        iterator& operator--()
+        {
+            if (m_Offset == 0)
+            {
+                --m_Piece;
+                m_Offset = m_Piece->m_Length;
+            }
+            m_Offset--;
+            return *this;
+        }
+        iterator operator--(int)
+        {
+            iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const iterator &b) const
+        {
+            return m_Piece == b.m_Piece && m_Offset == b.m_Offset;
+        }
+        bool operator!=(const iterator &b) const { return !(*this == b); }
+
+    private:
+        friend class TokenSequence;
+
+        iterator(PieceList::iterator piece, int offset)
+            :m_Piece(piece), m_Offset(offset) {}
+
+        /// The current piece, or the end of the piece list.
+        PieceList::iterator m_Piece;
+
+        /// The offset of the current token within the current piece.
+        int m_Offset;
+    };
+
+    /// Creates an empty sequence.
+    TokenSequence();
+
+    /// Creates a sequence sharing the pieces of another.
+    TokenSequence(const TokenSequence &sequence);
+
+    /// Drops the sequence's references to its buffers.
+    ~TokenSequence();
+
+    /// Replaces the sequence's pieces with those of another.
+    TokenSequence& operator=(const TokenSequence &sequence);
+
+    /// Returns the number of tokens in the sequence.
+    int length() const;
+
+    /// Returns the number of pieces in the sequence.
+    int pieceCount() const;
+
+    /// Appends every token of \p buffer.
+    void append(TokenBuffer *buffer);
+
+    /// Appends the tokens of another sequence from \p first up to \p last.
+    void append(iterator first, iterator last);
+
+    /// Inserts every token of \p buffer before \p pos.
+    iterator insert(iterator pos, TokenBuffer *buffer);
+
+    /// Inserts every token of \p sequence before \p pos.
+    iterator insert(iterator pos, const TokenSequence &sequence);
+
+    /// Removes the token at \p pos from the sequence.
+    iterator erase(iterator pos);
+
+    /// Appends copies of every token in the sequence to \p tokens.
+    void copyTo(TokenList &tokens) const;
+
+    iterator begin();
+    iterator end();
+
+private:
+    /// Splits the piece at \p pos so that \p pos begins a piece.
+    PieceList::iterator split(iterator pos);
+
+    /// The pieces, in order.
+    PieceList m_Pieces;
+
+    /// The total number of tokens in all pieces.
+    int m_Length;
+};
+
+#endif // TOKENSEQUENCE_H
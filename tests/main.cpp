@@ -35,10 +35,10 @@
 * line, preceeded by their lexeme formatted to a width of 12, padded by whitespace.
 ***********************************************************************************/
 #include <stdio.h>
-#include "../src/lex.h"
 #include "../src/token.h"
-#include "../src/tokenlist.h"
 #include "../src/symboltable.h"
+#include "../src/keywords.h"
+#include "../src/symbolimage.h"
 #include "../src/preprocessor.h"
 #include <iostream>
 #include <iomanip>
@@ -46,17 +46,13 @@
 #define OUTPUT_WIDTH    12 ///Formats output, pads lexemes to 12 chars
 
 /*!
- * \brief Outputs the token list to screen, for debugging.
- * \param tokenList The list of tokens to display.
+ * \brief Outputs a token to screen, for debugging.
+ * \param token The token to display.
  */
-void printTokenList(TokenList *tokenList)
+void printToken(const Token *token)
 {
-    for (int i = 0; i < tokenList->length(); i++)
-    {
-        Token *token = (*tokenList)[i];
-        std::cout << std::left << std::setw(OUTPUT_WIDTH) <<
-                     token->value() << token->type() << std::endl;
-    }
+    std::cout << std::left << std::setw(OUTPUT_WIDTH) <<
+                 token->lexeme() << token->type() << std::endl;
 }
 
 /*!
@@ -65,16 +61,7 @@ void printTokenList(TokenList *tokenList)
  */
 void initSymbolTable(SymbolTable &symbolTable)
 {
-    symbolTable.addSymbol("bool", ET_VOID, EU_KEYWORD, NULL);
-    symbolTable.addSymbol("break", ET_VOID, EU_KEYWORD, NULL);
-    symbolTable.addSymbol("else", ET_VOID, EU_KEYWORD, NULL);
-    symbolTable.addSymbol("false", ET_VOID, EU_KEYWORD, NULL);
-    symbolTable.addSymbol("if", ET_VOID, EU_KEYWORD, NULL);
-    symbolTable.addSymbol("int", ET_VOID, EU_KEYWORD, NULL);
-    symbolTable.addSymbol("return", ET_VOID, EU_KEYWORD, NULL);
-    symbolTable.addSymbol("true", ET_VOID, EU_KEYWORD, NULL);
-    symbolTable.addSymbol("void", ET_VOID, EU_KEYWORD, NULL);
-    symbolTable.addSymbol("while", ET_VOID, EU_KEYWORD, NULL);
+    symbolTable.addSymbols(LLC_KEYWORDS, LLC_KEYWORD_COUNT);
 }
 
 /*!
@@ -83,33 +70,36 @@ void initSymbolTable(SymbolTable &symbolTable)
  * \param argv  The values of the command line arguments.
  * \return 0 if everything goes okay.  Otherwise an error code.
  *
- * The compiler currently accepts one command-line variable, which is the path
- * to a file the user wants to parse.
+ * The compiler accepts the path to a file the user wants to parse, then
+ * optionally the path of a symbol image of predefined macros, as written by
+ * SymbolTable::saveImage().
  */
 int main (int argc, char* argv[])
 {
-    TokenList *tokenList = NULL;
+    // Map the predefined macros, if any, to start the global scope from
+    SymbolImage predefined;
+    if (argc > 2 && !predefined.load(argv[2]))
+    {
+        printf("could not load symbol image %s\n", argv[2]);
+        return -1;
+    }
 
     // Create and populate symbol table for compiler components
-    SymbolTable symbolTable;
+    SymbolTable symbolTable(predefined);
     initSymbolTable(symbolTable);
 
-    // Create a lexical analyzer and pass the symbol table to it
-    Lex lex(symbolTable);
-
-    if (argc > 0)
-        tokenList = lex.tokenizeFile(argv[1]);
+    // Preprocess the file as the lexical analyzer reads it
+    Preprocessor preprocessor(symbolTable);
+    if (argc > 1)
+        preprocessor.openFile(argv[1]);
     else
         return -1;
 
-    Preprocessor preprocessor(symbolTable);
-    preprocessor.process(*tokenList);
-
-    //Print tokens and clean up
-    if (tokenList)
+    //Print tokens as they come out and clean up
+    while (Token *token = preprocessor.nextToken())
     {
-        printTokenList(tokenList);
-        delete tokenList;
+        printToken(token);
+        delete token;
     }
 
     return 0;
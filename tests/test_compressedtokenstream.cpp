@@ -0,0 +1,154 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_compressedtokenstream.cpp
+ *
+ * \brief       Defines the test procedures declared in
+ *              test_compressedtokenstream.h
+ */
+#include <assert.h>
+#include <stdio.h>
+#include "test_compressedtokenstream.h"
+#include "../src/compressedtokenstream.h"
+#include "../src/token.h"
+#include "../src/tokenlist.h"
+
+/// Enough tokens to span several blocks, ending part way through one.
+#define TEST_TOKEN_COUNT    (TOKEN_BLOCK_SIZE * 5 + 7)
+
+/// Fills a list with a repetitive mix of identifiers, operators and constants.
+static void fillTokens(TokenList &tokens)
+{
+    char lexeme[16];
+    for (int i = 0; i < TEST_TOKEN_COUNT; i++)
+    {
+        switch (i % 4)
+        {
+            case 0:
+                snprintf(lexeme, sizeof(lexeme), "v%d", i % 50);
+                tokens.add(new Token(lexeme, "ID"));
+                break;
+            case 1:
+                tokens.add(new Token("=", "ASSIGNOP"));
+                break;
+            case 2:
+                snprintf(lexeme, sizeof(lexeme), "%d", i);
+                tokens.add(new Token(lexeme, "CONSTANT"));
+                break;
+            default:
+                tokens.add(new Token(";", ";"));
+        }
+    }
+}
+
+/// Deletes the tokens of a list; the list only frees its nodes.
+static void deleteTokens(TokenList &tokens)
+{
+    for (TokenList::iterator it = tokens.begin(); it != tokens.end(); ++it)
+        delete *it;
+}
+
+/*!
+ * \brief   Tests that decoding in order yields every token of the list.
+ */
+void TestCompressedTokenStream::test_iterate_manyBlocks_matchesList()
+{
+    TokenList tokens;
+    fillTokens(tokens);
+    CompressedTokenStream stream(tokens);
+    assert(stream.length() == TEST_TOKEN_COUNT);
+
+    CompressedTokenStream::iterator packed = stream.begin();
+    for (TokenList::iterator it = tokens.begin(); it != tokens.end(); ++it, ++packed)
+    {
+        assert(packed != stream.end());
+        assert(packed.lexeme() == (*it)->lexeme());
+        assert(packed.type() == (*it)->type());
+    }
+    assert(packed == stream.end());
+
+    TokenList copy;
+    stream.copyTo(copy);
+    assert(copy.length() == tokens.length());
+    assert((*--copy.end())->lexeme() == (*--tokens.end())->lexeme());
+
+    deleteTokens(copy);
+    deleteTokens(tokens);
+}
+
+/*!
+ * \brief   Tests that jumping to any token decodes the same token.
+ */
+void TestCompressedTokenStream::test_at_anyIndex_matchesList()
+{
+    TokenList tokens;
+    fillTokens(tokens);
+    CompressedTokenStream stream(tokens);
+
+    int i = 0;
+    for (TokenList::iterator it = tokens.begin(); it != tokens.end(); ++it, i++)
+    {
+        CompressedTokenStream::iterator packed = stream.at(i);
+        assert(packed.index() == i);
+        assert(packed.lexeme() == (*it)->lexeme());
+    }
+    assert(stream.at(TEST_TOKEN_COUNT) == stream.end());
+
+    deleteTokens(tokens);
+}
+
+/*!
+ * \brief   Tests that the line of each token, and whether whitespace came
+ *          before it, survive the encoding, across blocks and at any index.
+ */
+void TestCompressedTokenStream::test_copyTo_linesAndSpacing_preserved()
+{
+    TokenList tokens;
+    for (int i = 0; i < TEST_TOKEN_COUNT; i++)
+    {
+        Token *token = new Token(i % 3 ? "x" : "(", i % 3 ? "ID" : "(",
+                                 i / 5 + 1 - (i % 7 == 6));
+        token->setLeadingSpace(i % 3 == 1);
+        tokens.add(token);
+    }
+    CompressedTokenStream stream(tokens);
+
+    TokenList copy;
+    stream.copyTo(copy);
+    TokenList::iterator it = tokens.begin(), copied = copy.begin();
+    for (int i = 0; it != tokens.end(); ++it, ++copied, i++)
+    {
+        assert((*copied)->line() == (*it)->line());
+        assert((*copied)->leadingSpace() == (*it)->leadingSpace());
+        assert(stream.at(i).line() == (*it)->line());
+    }
+
+    deleteTokens(copy);
+    deleteTokens(tokens);
+}
+
+/*!
+ * \brief   Tests that repetitive tokens compress to a few bytes each, counting
+ *          the tables used while encoding, and that freezing drops the tables.
+ */
+void TestCompressedTokenStream::test_memoryUsage_repetitiveTokens_fewBytesPerToken()
+{
+    TokenList tokens;
+    for (int i = 0; i < 10000; i++)
+        tokens.add(new Token(i % 2 ? "x" : ";", i % 2 ? "ID" : ";", i / 10 + 1));
+    CompressedTokenStream stream(tokens);
+
+    size_t usage = stream.memoryUsage();
+    stream.freeze();
+    assert(stream.memoryUsage() < usage);
+    assert(stream.memoryUsage() < 10000 * 3);
+    assert(stream.at(9999).lexeme() == "x" && stream.at(9999).line() == 1000);
+
+    stream.append(Token("y", "ID", 1001));
+    assert(stream.at(10000).lexeme() == "y" && stream.at(10000).line() == 1001);
+    assert(stream.at(9999).lexeme() == "x");
+
+    deleteTokens(tokens);
+}
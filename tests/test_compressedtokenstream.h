@@ -0,0 +1,28 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_compressedtokenstream.h
+ *
+ * \brief       Declares the test procedures for the CompressedTokenStream
+ *              class.
+ */
+#ifndef TEST_COMPRESSEDTOKENSTREAM_H
+#define TEST_COMPRESSEDTOKENSTREAM_H
+
+/*!
+ * \brief   The TestCompressedTokenStream class is a container of test
+ *          procedures for ensuring a compressed stream decodes to the tokens
+ *          it was built from.
+ */
+class TestCompressedTokenStream
+{
+public:
+    void test_iterate_manyBlocks_matchesList();
+    void test_at_anyIndex_matchesList();
+    void test_copyTo_linesAndSpacing_preserved();
+    void test_memoryUsage_repetitiveTokens_fewBytesPerToken();
+};
+
+#endif // TEST_COMPRESSEDTOKENSTREAM_H
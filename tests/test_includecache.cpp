@@ -0,0 +1,224 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_includecache.cpp
+ *
+ * \brief       Defines the test procedures declared in test_includecache.h
+ */
+#include <assert.h>
+#include <stdio.h>
+#include <string>
+#include "test_includecache.h"
+#include "../src/includecache.h"
+#include "../src/keywords.h"
+#include "../src/preprocessor.h"
+#include "../src/symboltable.h"
+#include "../src/token.h"
+#include "../src/tokensequence.h"
+
+#if !defined(_MSC_VER)
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#endif
+
+/// The files the tests write and include.
+#define TEST_HEADER_PATH    "test_includecache.h.tmp"
+#define TEST_SOURCE_PATH    "test_includecache.cpp.tmp"
+
+/*!
+ * \brief   Writes \p text to the file at \p path.
+ */
+static void writeFile(const char *path, const char *text)
+{
+    FILE *file = fopen(path, "w");
+    assert(file);
+    fputs(text, file);
+    fclose(file);
+}
+
+/*!
+ * \brief   Tests that a file looked up twice, by two spellings of its path, is
+ *          lexed once and its tokens shared.
+ */
+void TestIncludeCache::test_tokens_samePath_lexedOnce()
+{
+    writeFile(TEST_HEADER_PATH, "int a = 1;\n");
+
+    IncludeCache cache;
+    TokenBuffer *first = cache.tokens(TEST_HEADER_PATH);
+    TokenBuffer *second = cache.tokens("./" TEST_HEADER_PATH);
+    assert(first && first == second);
+    assert(first->length() == 5);
+    assert(first->token(1)->lexeme() == "a");
+    assert(cache.size() == 1);
+    assert(cache.lexCount() == 1);
+
+    assert(!cache.tokens("no such header.h"));
+
+    first->release();
+    second->release();
+    remove(TEST_HEADER_PATH);
+}
+
+/*!
+ * \brief   Tests that a file which changes size is lexed again, while tokens
+ *          already handed out stay as they were.
+ */
+void TestIncludeCache::test_tokens_changedFile_lexedAgain()
+{
+    writeFile(TEST_HEADER_PATH, "int a;\n");
+
+    IncludeCache cache;
+    TokenBuffer *before = cache.tokens(TEST_HEADER_PATH);
+    writeFile(TEST_HEADER_PATH, "int a, b;\n");
+    TokenBuffer *after = cache.tokens(TEST_HEADER_PATH);
+
+    assert(before != after);
+    assert(before->length() == 3);
+    assert(after->length() == 5);
+    assert(cache.size() == 1);
+    assert(cache.lexCount() == 2);
+
+    // The cache lets go of its tokens, the includers keep theirs
+    cache.clear();
+    assert(cache.size() == 0);
+    assert(before->token(1)->lexeme() == "a");
+
+    before->release();
+    after->release();
+    remove(TEST_HEADER_PATH);
+}
+
+/*!
+ * \brief   Tests that a file rewritten to the same size within the second it
+ *          was lexed is lexed again, where times are kept in nanoseconds.
+ */
+void TestIncludeCache::test_tokens_touchedWithinSecond_lexedAgain()
+{
+#if !defined(_MSC_VER)
+    struct timespec times[2];
+    times[0].tv_sec = times[1].tv_sec = 1000000000;
+
+    writeFile(TEST_HEADER_PATH, "int a;\n");
+    times[0].tv_nsec = times[1].tv_nsec = 100;
+    assert(utimensat(AT_FDCWD, TEST_HEADER_PATH, times, 0) == 0);
+
+    IncludeCache cache;
+    TokenBuffer *before = cache.tokens(TEST_HEADER_PATH);
+
+    writeFile(TEST_HEADER_PATH, "int b;\n");
+    times[0].tv_nsec = times[1].tv_nsec = 200;
+    assert(utimensat(AT_FDCWD, TEST_HEADER_PATH, times, 0) == 0);
+    TokenBuffer *after = cache.tokens(TEST_HEADER_PATH);
+
+    assert(before != after);
+    assert(after->token(1)->lexeme() == "b");
+    assert(cache.lexCount() == 2);
+
+    before->release();
+    after->release();
+    remove(TEST_HEADER_PATH);
+#endif
+}
+
+/*!
+ * \brief   Tests that preprocessors sharing a cache lex a header once, however
+ *          often it is included, and each replaces its own macros in it.
+ */
+void TestIncludeCache::test_preprocessor_sharedCache_includeLexedOnce()
+{
+    writeFile(TEST_HEADER_PATH, "int SIZE;\n");
+    writeFile(TEST_SOURCE_PATH, "#include \"" TEST_HEADER_PATH "\"\n"
+                                "#include \"" TEST_HEADER_PATH "\"\n");
+
+    IncludeCache cache;
+    const char *sizes[] = { "4", "8" };
+    for (int i = 0; i < 2; i++)
+    {
+        SymbolTable st;
+        st.addSymbol("SIZE", ET_VOID, EU_CONSTANT, sizes[i]);
+
+        Preprocessor preprocessor(st, &cache);
+        assert(preprocessor.openFile(TEST_SOURCE_PATH));
+
+        int count = 0;
+        while (Token *token = preprocessor.nextToken())
+        {
+            if (count % 3 == 1)
+                assert(token->lexeme() == sizes[i]);
+            count++;
+            delete token;
+        }
+        assert(count == 6);
+    }
+    assert(cache.lexCount() == 1);
+
+    remove(TEST_SOURCE_PATH);
+    remove(TEST_HEADER_PATH);
+}
+
+/*!
+ * \brief   Tests that the guard of a file wrapped whole in #ifndef ... #endif
+ *          is found, and that no guard is found for a file with tokens past
+ *          its #endif.
+ */
+void TestIncludeCache::test_tokens_guardedFile_reportsGuard()
+{
+    writeFile(TEST_HEADER_PATH, "#ifndef GUARDH\n#define GUARDH\n"
+                                "#ifdef DEBUG\nint debug;\n#endif\n"
+                                "int a;\n#endif\n");
+    writeFile(TEST_SOURCE_PATH, "#ifndef GUARDH\nint a;\n#endif\nint b;\n");
+
+    IncludeCache cache;
+    std::string guard;
+    TokenBuffer *tokens = cache.tokens(TEST_HEADER_PATH, &guard);
+    assert(guard == "GUARDH");
+    tokens->release();
+
+    // Found again from the cache
+    guard.clear();
+    tokens = cache.tokens(TEST_HEADER_PATH, &guard);
+    assert(guard == "GUARDH");
+    tokens->release();
+
+    tokens = cache.tokens(TEST_SOURCE_PATH, &guard);
+    assert(guard.empty());
+    tokens->release();
+
+    remove(TEST_SOURCE_PATH);
+    remove(TEST_HEADER_PATH);
+}
+
+/*!
+ * \brief   Tests that a guarded header included again after its guard is
+ *          defined yields nothing, and is included in full after the guard is
+ *          undefined.
+ */
+void TestIncludeCache::test_preprocessor_guardDefined_skipsInclude()
+{
+    writeFile(TEST_HEADER_PATH, "#ifndef GUARDH\n#define GUARDH\n"
+                                "int a;\n#endif\n");
+    writeFile(TEST_SOURCE_PATH, "#include \"" TEST_HEADER_PATH "\"\n"
+                                "#include \"" TEST_HEADER_PATH "\"\n"
+                                "#undef GUARDH\n"
+                                "#include \"" TEST_HEADER_PATH "\"\n");
+
+    SymbolTable st;
+    st.addSymbols(LLC_KEYWORDS, LLC_KEYWORD_COUNT);
+    Preprocessor preprocessor(st);
+    assert(preprocessor.openFile(TEST_SOURCE_PATH));
+
+    int count = 0;
+    while (Token *token = preprocessor.nextToken())
+    {
+        count++;
+        delete token;
+    }
+    assert(count == 6);
+    assert(!st.findSymbol("GUARDH").isNull());
+
+    remove(TEST_SOURCE_PATH);
+    remove(TEST_HEADER_PATH);
+}
@@ -0,0 +1,31 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_includecache.h
+ *
+ * \brief       Declares the test procedures for the IncludeCache class.
+ */
+#ifndef TEST_INCLUDECACHE_H
+#define TEST_INCLUDECACHE_H
+
+/*!
+ * \brief   The TestIncludeCache class is a container of test procedures for
+ *          ensuring included files are lexed once, and again only when they
+ *          change, and that their include guards are found.
+ */
+class TestIncludeCache
+{
+public:
+    void test_tokens_samePath_lexedOnce();
+    void test_tokens_changedFile_lexedAgain();
+    void test_tokens_touchedWithinSecond_lexedAgain();
+    void test_preprocessor_sharedCache_includeLexedOnce();
+
+    /// Include guard tests
+    void test_tokens_guardedFile_reportsGuard();
+    void test_preprocessor_guardDefined_skipsInclude();
+};
+
+#endif // TEST_INCLUDECACHE_H
@@ -0,0 +1,368 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_preprocessor.cpp
+ *
+ * \brief       Defines the test procedures declared in test_preprocessor.h
+ */
+#include <assert.h>
+#include <stdio.h>
+#include <string>
+#include "test_preprocessor.h"
+#include "../src/keywords.h"
+#include "../src/lex.h"
+#include "../src/macroexpander.h"
+#include "../src/preprocessor.h"
+#include "../src/symboltable.h"
+#include "../src/token.h"
+#include "../src/tokenlist.h"
+
+/// The files the tests write and include.
+#define TEST_HEADER_PATH    "test_preprocessor.h.tmp"
+#define TEST_SOURCE_PATH    "test_preprocessor.cpp.tmp"
+
+/// Nested conditionals, both active and inactive, and what they leave.
+#define NESTED_CONDITIONALS "#define A 1\n"         \
+                            "#ifdef A\n"            \
+                            "int a;\n"              \
+                            "  #ifdef B\n"          \
+                            "int b;\n"              \
+                            "    #ifndef A\n"       \
+                            "int x;\n"              \
+                            "    #endif\n"          \
+                            "int y;\n"              \
+                            "  #endif\n"            \
+                            "int c;\n"              \
+                            "#endif\n"              \
+                            "#ifndef A\n"           \
+                            "#ifdef A\n"            \
+                            "int d;\n"              \
+                            "#endif\n"              \
+                            "int e;\n"              \
+                            "#endif\n"              \
+                            "int f;\n"
+#define NESTED_RESULT       "int a ; int c ; int f ;"
+
+/*!
+ * \brief   Writes \p text to the file at \p path.
+ */
+static void writeFile(const char *path, const char *text)
+{
+    FILE *file = fopen(path, "w");
+    assert(file);
+    fputs(text, file);
+    fclose(file);
+}
+
+/*!
+ * \brief   Preprocesses the file at \p path.
+ * \return  The lexemes of the preprocessed tokens, separated by spaces.
+ */
+static std::string preprocessFile(const char *path)
+{
+    SymbolTable st;
+    st.addSymbols(LLC_KEYWORDS, LLC_KEYWORD_COUNT);
+    Preprocessor preprocessor(st);
+    assert(preprocessor.openFile(path));
+
+    std::string text;
+    while (Token *token = preprocessor.nextToken())
+    {
+        text += (text.empty() ? "" : " ") + token->lexeme();
+        delete token;
+    }
+    return text;
+}
+
+/*!
+ * \brief   Tests that a header marked #pragma once is read only once, though
+ *          it is included by several spellings of its path.
+ */
+void TestPreprocessor::test_include_pragmaOnce_readOnceByAnyPath()
+{
+    writeFile(TEST_HEADER_PATH, "#pragma once\nint a;\n");
+    writeFile(TEST_SOURCE_PATH, "#include \"" TEST_HEADER_PATH "\"\n"
+                                "#include \"./" TEST_HEADER_PATH "\"\n"
+                                "#include \"././" TEST_HEADER_PATH "\"\n"
+                                "int b;\n");
+
+    assert(preprocessFile(TEST_SOURCE_PATH) == "int a ; int b ;");
+
+    remove(TEST_SOURCE_PATH);
+    remove(TEST_HEADER_PATH);
+}
+
+/*!
+ * \brief   Tests that a file which includes itself is not read into itself.
+ */
+void TestPreprocessor::test_include_itself_prevented()
+{
+    writeFile(TEST_HEADER_PATH, "int a;\n#include \"" TEST_HEADER_PATH "\"\n");
+    writeFile(TEST_SOURCE_PATH, "#include \"" TEST_HEADER_PATH "\"\n"
+                                "#include \"" TEST_SOURCE_PATH "\"\n"
+                                "int b;\n");
+
+    assert(preprocessFile(TEST_SOURCE_PATH) == "int a ; int b ;");
+
+    remove(TEST_SOURCE_PATH);
+    remove(TEST_HEADER_PATH);
+}
+
+/*!
+ * \brief   Tests that regions nested in an inactive region are skipped whole,
+ *          whatever their own conditions, and that the #endif of an active
+ *          region nested in an active one closes only the inner one.
+ */
+void TestPreprocessor::test_conditional_nested_skipsInactiveRegions()
+{
+    writeFile(TEST_SOURCE_PATH, NESTED_CONDITIONALS);
+
+    assert(preprocessFile(TEST_SOURCE_PATH) == NESTED_RESULT);
+
+    remove(TEST_SOURCE_PATH);
+}
+
+/*!
+ * \brief   Tests that inactive regions are skipped alike in a file being lexed,
+ *          an included file and a list of tokens.
+ */
+void TestPreprocessor::test_conditional_nested_sameForEverySource()
+{
+    writeFile(TEST_HEADER_PATH, NESTED_CONDITIONALS);
+    writeFile(TEST_SOURCE_PATH, "#include \"" TEST_HEADER_PATH "\"\n");
+
+    assert(preprocessFile(TEST_SOURCE_PATH) == NESTED_RESULT);
+
+    SymbolTable st;
+    st.addSymbols(LLC_KEYWORDS, LLC_KEYWORD_COUNT);
+    Lex lex;
+    TokenList *tokens = lex.tokenizeString(NESTED_CONDITIONALS);
+    Preprocessor preprocessor(st);
+    preprocessor.process(*tokens);
+
+    std::string text;
+    for (TokenList::iterator it = tokens->begin(); it != tokens->end(); ++it)
+    {
+        text += (text.empty() ? "" : " ") + (*it)->lexeme();
+        delete *it;
+    }
+    delete tokens;
+    assert(text == NESTED_RESULT);
+
+    remove(TEST_SOURCE_PATH);
+    remove(TEST_HEADER_PATH);
+}
+
+/*!
+ * \brief   Tests that the arguments of a function-like macro, split at the
+ *          commas outside nested parentheses, replace its parameters, and that
+ *          its name alone is left as it is.
+ */
+void TestPreprocessor::test_define_functionLike_substitutesArguments()
+{
+    writeFile(TEST_SOURCE_PATH, "#define ADD(a, b) a + b * (a)\n"
+                                "#define NIL() 0\n"
+                                "int y = ADD(f(1, 2), (3, 4));\n"
+                                "int z = ADD NIL() NIL( );\n"
+                                "int w = ADD(1,\n"
+                                "  2);\n");
+
+    assert(preprocessFile(TEST_SOURCE_PATH) ==
+           "int y = f ( 1 , 2 ) + ( 3 , 4 ) * ( f ( 1 , 2 ) ) ; "
+           "int z = ADD 0 0 ; "
+           "int w = 1 + 2 * ( 1 ) ;");
+
+    remove(TEST_SOURCE_PATH);
+}
+
+/*!
+ * \brief   Tests that a macro is function-like only when a '(' follows its
+ *          name with no space between, and is otherwise object-like with a
+ *          body beginning with '('.
+ */
+void TestPreprocessor::test_define_spaceBeforeParenthesis_objectLike()
+{
+    writeFile(TEST_SOURCE_PATH, "#define F(x) x + 1\n"
+                                "#define G (x) x\n"
+                                "#define TWO (1 + 2)\n"
+                                "int a = F(2);\n"
+                                "int b = G;\n"
+                                "int c = TWO;\n");
+
+    assert(preprocessFile(TEST_SOURCE_PATH) ==
+           "int a = 2 + 1 ; "
+           "int b = ( x ) x ; "
+           "int c = ( 1 + 2 ) ;");
+
+    remove(TEST_SOURCE_PATH);
+}
+
+/*!
+ * \brief   Tests that a macro met again within its own expansion is left as
+ *          it is, rather than expanded without end, even when its name ends
+ *          the expansion and arguments follow the invocation.
+ */
+void TestPreprocessor::test_define_selfReferent_notExpandedAgain()
+{
+    writeFile(TEST_SOURCE_PATH, "#define F(x) F(x) + 1\n"
+                                "#define G(x) H(x)\n"
+                                "#define H(x) G(x) * 2\n"
+                                "#define f(x) f\n"
+                                "#define g(x) h\n"
+                                "#define h(x) g\n"
+                                "#define K f(1)(2)\n"
+                                "int y = F(F(2));\n"
+                                "int z = G(3);\n"
+                                "int u = f(1)(2)(3);\n"
+                                "int v = K;\n"
+                                "int w = g(1)(2)(3);\n");
+
+    assert(preprocessFile(TEST_SOURCE_PATH) ==
+           "int y = F ( F ( 2 ) + 1 ) + 1 ; "
+           "int z = G ( 3 ) * 2 ; "
+           "int u = f ( 2 ) ( 3 ) ; "
+           "int v = f ( 2 ) ; "
+           "int w = h ;");
+
+    remove(TEST_SOURCE_PATH);
+}
+
+/*!
+ * \brief   Tests that a macro whose value is an identifier is rescanned, so
+ *          that chains of macros are followed to their end, and that a
+ *          function-like macro named by one takes the arguments after it.
+ */
+void TestPreprocessor::test_define_identifierValue_rescanned()
+{
+    writeFile(TEST_SOURCE_PATH, "#define F(x) x + 1\n"
+                                "#define H F\n"
+                                "#define A B\n"
+                                "#define B 3\n"
+                                "#define P Q\n"
+                                "#define Q P\n"
+                                "#define M H(A) * A\n"
+                                "int a = H(2);\n"
+                                "int b = A;\n"
+                                "int c = P Q;\n"
+                                "int d = M;\n"
+                                "int e = H;\n");
+
+    assert(preprocessFile(TEST_SOURCE_PATH) ==
+           "int a = 2 + 1 ; "
+           "int b = 3 ; "
+           "int c = P Q ; "
+           "int d = 3 + 1 * 3 ; "
+           "int e = F ;");
+
+    remove(TEST_SOURCE_PATH);
+}
+
+/*!
+ * \brief   Tests that an object-like macro is replaced by all the tokens of its
+ *          line, or by none when it has none.
+ */
+void TestPreprocessor::test_define_objectLike_multipleAndNoTokens()
+{
+    writeFile(TEST_SOURCE_PATH, "#define EMPTY\n"
+                                "#define DECL int x = ONE;\n"
+                                "#define ONE 1\n"
+                                "EMPTY DECL EMPTY\n"
+                                "#undef DECL\n"
+                                "DECL\n");
+
+    assert(preprocessFile(TEST_SOURCE_PATH) == "int x = 1 ; DECL");
+
+    remove(TEST_SOURCE_PATH);
+}
+
+/*!
+ * \brief   Tests that a macro defined or undefined between two invocations of
+ *          another, whose body names it, changes the second invocation.
+ */
+void TestPreprocessor::test_define_afterInvocation_seenByNextInvocation()
+{
+    writeFile(TEST_SOURCE_PATH, "#define INC(x) x + ONE\n"
+                                "int a = INC(1);\n"
+                                "#define ONE 1\n"
+                                "int b = INC(1);\n"
+                                "#define TWO 2\n"
+                                "int c = INC(1);\n"
+                                "#undef ONE\n"
+                                "int d = INC(1);\n");
+
+    assert(preprocessFile(TEST_SOURCE_PATH) ==
+           "int a = 1 + ONE ; "
+           "int b = 1 + 1 ; "
+           "int c = 1 + 1 ; "
+           "int d = 1 + ONE ;");
+
+    remove(TEST_SOURCE_PATH);
+}
+
+/*!
+ * \brief   Tests that invoking a macro again with the same arguments finds the
+ *          expansion memoized, sharing its tokens, until a name it looked up
+ *          is defined, and that arguments of other types are not the same.
+ */
+void TestPreprocessor::test_expand_sameArguments_memoizedAndShared()
+{
+    SymbolTable st;
+    st.addSymbols(LLC_KEYWORDS, LLC_KEYWORD_COUNT);
+    Lex lex;
+    MacroExpander expander(st);
+
+    std::vector<std::string> parameters(1, "a");
+    TokenList *body = lex.tokenizeString("a + a\n");
+    expander.define("TWICE", &parameters, *body);
+    delete body;
+
+    TokenList *argument = lex.tokenizeString("x * 2\n");
+    TokenBuffer *buffer = new TokenBuffer(*argument);
+    delete argument;
+    std::vector<TokenSequence> arguments(1);
+    arguments[0].append(buffer);
+    buffer->release();
+
+    TokenSequence first, second, third, fourth, fifth, sixth;
+    assert(expander.expand("TWICE", arguments, first));
+    assert(expander.expand("TWICE", arguments, second));
+    assert(expander.memoHits() == 1);
+    assert(first.length() == 7 && second.length() == 7);
+    assert(*first.begin() == *second.begin());
+    assert(*first.begin() == buffer->token(0));
+
+    // A macro the expansion never looked up leaves it memoized
+    expander.undefine("NONE");
+    assert(expander.expand("TWICE", arguments, third));
+    assert(expander.memoHits() == 2);
+
+    // A macro named in its argument does not
+    body = lex.tokenizeString("3\n");
+    expander.define("x", 0, *body);
+    delete body;
+    assert(expander.expand("TWICE", arguments, fourth));
+    assert(expander.memoHits() == 2);
+    assert(fourth.length() == 7);
+    assert((*fourth.begin())->lexeme() == "3");
+
+    // Nor does it survive the macro's own undefinition
+    expander.undefine("x");
+    assert(expander.expand("TWICE", arguments, fifth));
+    assert(expander.memoHits() == 2);
+    assert((*fifth.begin())->lexeme() == "x");
+
+    // The same lexemes of another type are other arguments
+    TokenList string;
+    string.add(new Token("x", "STRING"));
+    string.add(new Token("*", "*"));
+    string.add(new Token("2", "CONSTANT"));
+    buffer = new TokenBuffer(string);
+    std::vector<TokenSequence> strings(1);
+    strings[0].append(buffer);
+    buffer->release();
+    assert(expander.expand("TWICE", strings, sixth));
+    assert(expander.memoHits() == 2);
+    assert(*sixth.begin() == buffer->token(0));
+}
@@ -0,0 +1,38 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_preprocessor.h
+ *
+ * \brief       Declares the test procedures for the Preprocessor class.
+ */
+#ifndef TEST_PREPROCESSOR_H
+#define TEST_PREPROCESSOR_H
+
+/*!
+ * \brief   The TestPreprocessor class is a container of test procedures for
+ *          ensuring the preprocessor acts on its directives correctly.
+ */
+class TestPreprocessor
+{
+public:
+    /// Include tests
+    void test_include_pragmaOnce_readOnceByAnyPath();
+    void test_include_itself_prevented();
+
+    /// Conditional tests
+    void test_conditional_nested_skipsInactiveRegions();
+    void test_conditional_nested_sameForEverySource();
+
+    /// Macro tests
+    void test_define_functionLike_substitutesArguments();
+    void test_define_spaceBeforeParenthesis_objectLike();
+    void test_define_selfReferent_notExpandedAgain();
+    void test_define_identifierValue_rescanned();
+    void test_define_objectLike_multipleAndNoTokens();
+    void test_define_afterInvocation_seenByNextInvocation();
+    void test_expand_sameArguments_memoizedAndShared();
+};
+
+#endif // TEST_PREPROCESSOR_H
@@ -0,0 +1,152 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_symbolimage.cpp
+ *
+ * \brief       Defines the test procedures declared in test_symbolimage.h
+ */
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "test_symbolimage.h"
+#include "../src/symbolimage.h"
+#include "../src/symboltable.h"
+
+/// The file the tests write images to.
+#define TEST_IMAGE_PATH     "test_symbolimage.bin"
+
+/// The number of macros saved, enough for the image to probe past collisions.
+#define TEST_MACRO_COUNT    1000
+
+/// Two names with the same 32-bit FNV-1a hash.
+#define COLLIDING_NAME_A    "m763399"
+#define COLLIDING_NAME_B    "m1109514"
+
+/*!
+ * \brief   Saves a table of many macros, including two whose hashes collide.
+ */
+static void saveTestImage()
+{
+    SymbolTable st;
+    char name[16], value[16];
+    for (int i = 0; i < TEST_MACRO_COUNT; i++)
+    {
+        snprintf(name, sizeof(name), "MACRO%d", i);
+        snprintf(value, sizeof(value), "%d", i);
+        assert(st.addSymbol(name, ET_INTEGER, EU_MACRO, value));
+    }
+    assert(st.addSymbol(COLLIDING_NAME_A, ET_VOID, EU_MACRO, 0));
+    assert(st.addSymbol(COLLIDING_NAME_B, ET_VOID, EU_ID, "b"));
+
+    // Only the symbols visible from the current scope are saved
+    st.pushScope();
+    assert(st.addSymbol("MACRO7", ET_CHAR, EU_MACRO, "shadow"));
+    assert(st.saveImage(TEST_IMAGE_PATH));
+}
+
+/*!
+ * \brief   Tests that every saved symbol is found, with its data, in a table
+ *          built on the loaded image.
+ */
+void TestSymbolImage::test_saveImage_thenLoad_tableFindsSymbols()
+{
+    saveTestImage();
+
+    SymbolImage image;
+    assert(image.load(TEST_IMAGE_PATH));
+    assert(image.size() == TEST_MACRO_COUNT + 2);
+
+    SymbolTable st(image);
+    char name[16], value[16];
+    for (int i = 0; i < TEST_MACRO_COUNT; i++)
+    {
+        snprintf(name, sizeof(name), "MACRO%d", i);
+        snprintf(value, sizeof(value), "%d", i);
+        SymbolPtr symbol = st.findSymbol(name);
+        assert(!symbol.isNull());
+        assert(!strcmp(symbol.name(), name));
+        assert(!strcmp(symbol.constData(), i == 7 ? "shadow" : value));
+        assert(symbol == st.findSymbol(name));
+    }
+
+    SymbolPtr b = st.findSymbol(COLLIDING_NAME_B);
+    assert(b.use() == EU_ID && !strcmp(b.constData(), "b"));
+    assert(!st.findSymbol(COLLIDING_NAME_A).constData());
+    assert(st.findSymbol("MACRO1000").isNull());
+
+    // Image symbols belong to the global scope
+    assert(!st.addSymbol("MACRO1", ET_VOID, EU_MACRO, 0));
+    st.pushScope();
+    assert(st.addSymbol("MACRO1", ET_VOID, EU_MACRO, "inner"));
+    st.popScope();
+    assert(!strcmp(st.findSymbol("MACRO1").constData(), "1"));
+
+    remove(TEST_IMAGE_PATH);
+}
+
+/*!
+ * \brief   Tests that removing an image symbol hides it from one table only,
+ *          and that the name may then be declared again.
+ */
+void TestSymbolImage::test_removeSymbol_fromImage_onlyHiddenFromTable()
+{
+    saveTestImage();
+
+    SymbolImage image;
+    assert(image.load(TEST_IMAGE_PATH));
+    SymbolTable first(image);
+    SymbolTable second(image);
+
+    assert(!first.findSymbol("MACRO3").isNull());
+    first.removeSymbol("MACRO3");
+    first.removeSymbol("MACRO4");
+    assert(first.findSymbol("MACRO3").isNull());
+    assert(first.findSymbol("MACRO4").isNull());
+    assert(!first.findSymbol("MACRO5").isNull());
+    assert(!strcmp(second.findSymbol("MACRO3").constData(), "3"));
+
+    assert(first.addSymbol("MACRO3", ET_INTEGER, EU_MACRO, "33"));
+    assert(!strcmp(first.findSymbol("MACRO3").constData(), "33"));
+
+    SymbolSnapshot snapshot = first.snapshot();
+    assert(snapshot.size() == TEST_MACRO_COUNT + 1);
+    assert(snapshot.findSymbol("MACRO4").isNull());
+    assert(!strcmp(snapshot.findSymbol("MACRO3").constData(), "33"));
+
+    remove(TEST_IMAGE_PATH);
+}
+
+/*!
+ * \brief   Tests that a missing, truncated or foreign file is not loaded.
+ */
+void TestSymbolImage::test_load_invalidFile_fails()
+{
+    SymbolImage image;
+    assert(!image.load("no such image.bin"));
+
+    FILE *file = fopen(TEST_IMAGE_PATH, "wb");
+    assert(file);
+    fputs("#define NOT_AN_IMAGE 1\n", file);
+    fclose(file);
+    assert(!image.load(TEST_IMAGE_PATH));
+    assert(image.size() == 0);
+
+    // A valid image cut short is rejected too
+    saveTestImage();
+    file = fopen(TEST_IMAGE_PATH, "rb");
+    static char data[1 << 16];
+    size_t size = fread(data, 1, sizeof(data), file);
+    assert(size < sizeof(data));
+    fclose(file);
+    file = fopen(TEST_IMAGE_PATH, "wb");
+    fwrite(data, 1, size - 1, file);
+    fclose(file);
+    assert(!image.load(TEST_IMAGE_PATH));
+
+    SymbolTable st(image);
+    assert(st.findSymbol("MACRO1").isNull());
+
+    remove(TEST_IMAGE_PATH);
+}
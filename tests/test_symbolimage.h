@@ -0,0 +1,26 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_symbolimage.h
+ *
+ * \brief       Declares the test procedures for the SymbolImage class.
+ */
+#ifndef TEST_SYMBOLIMAGE_H
+#define TEST_SYMBOLIMAGE_H
+
+/*!
+ * \brief   The TestSymbolImage class is a container of test procedures for
+ *          ensuring symbol tables saved as images load back unchanged, and
+ *          that tables built on an image see its symbols.
+ */
+class TestSymbolImage
+{
+public:
+    void test_saveImage_thenLoad_tableFindsSymbols();
+    void test_removeSymbol_fromImage_onlyHiddenFromTable();
+    void test_load_invalidFile_fails();
+};
+
+#endif // TEST_SYMBOLIMAGE_H
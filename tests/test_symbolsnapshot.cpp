@@ -0,0 +1,159 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_symbolsnapshot.cpp
+ *
+ * \brief       Defines the test procedures declared in test_symbolsnapshot.h
+ */
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "test_symbolsnapshot.h"
+#include "../src/symbolsnapshot.h"
+#include "../src/symboltable.h"
+
+/// The number of symbols used to build a trie several levels deep.
+#define TEST_SYMBOL_COUNT   2000
+
+/// Two names with the same 32-bit FNV-1a hash.
+#define COLLIDING_NAME_A    "m763399"
+#define COLLIDING_NAME_B    "m1109514"
+
+/*!
+ * \brief   Tests that every added symbol is found, and removing half of them
+ *          leaves exactly the other half.
+ */
+void TestSymbolSnapshot::test_addSymbol_manySymbols_allFound()
+{
+    SymbolSnapshot snapshot;
+    char name[16];
+    for (int i = 0; i < TEST_SYMBOL_COUNT; i++)
+    {
+        snprintf(name, sizeof(name), "s%d", i);
+        assert(snapshot.addSymbol(name, ET_INTEGER, EU_VARIABLE, name));
+    }
+    assert(!snapshot.addSymbol("s7", ET_INTEGER, EU_VARIABLE, 0));
+    assert(snapshot.size() == TEST_SYMBOL_COUNT);
+
+    for (int i = 0; i < TEST_SYMBOL_COUNT; i += 2)
+    {
+        snprintf(name, sizeof(name), "s%d", i);
+        snapshot.removeSymbol(name);
+    }
+    assert(snapshot.size() == TEST_SYMBOL_COUNT / 2);
+
+    for (int i = 0; i < TEST_SYMBOL_COUNT; i++)
+    {
+        snprintf(name, sizeof(name), "s%d", i);
+        SymbolPtr symbol = snapshot.findSymbol(name);
+        assert(symbol.isNull() == (i % 2 == 0));
+        assert(symbol.isNull() || !strcmp(symbol.constData(), name));
+    }
+}
+
+/*!
+ * \brief   Tests that writes to a copy, and to the original after copying,
+ *          are not seen by the other.
+ */
+void TestSymbolSnapshot::test_copy_thenWrite_originalUnchanged()
+{
+    SymbolSnapshot base;
+    char name[16];
+    for (int i = 0; i < 100; i++)
+    {
+        snprintf(name, sizeof(name), "k%d", i);
+        base.addSymbol(name, ET_VOID, EU_KEYWORD, 0);
+    }
+
+    SymbolSnapshot fork(base);
+    fork.removeSymbol("k5");
+    fork.addSymbol("extra", ET_VOID, EU_MACRO, "1");
+    base.removeSymbol("k6");
+
+    assert(!base.findSymbol("k5").isNull());
+    assert(base.findSymbol("k6").isNull());
+    assert(base.findSymbol("extra").isNull());
+    assert(fork.findSymbol("k5").isNull());
+    assert(!fork.findSymbol("k6").isNull());
+    assert(!fork.findSymbol("extra").isNull());
+    assert(base.size() == 99 && fork.size() == 100);
+
+    fork = base;
+    assert(fork.findSymbol("extra").isNull());
+    assert(fork.size() == 99);
+}
+
+/*!
+ * \brief   Tests that names whose hashes collide are told apart, and removing
+ *          one leaves the other.
+ */
+void TestSymbolSnapshot::test_removeSymbol_collidingNames_otherKept()
+{
+    assert(hashSymbolName(COLLIDING_NAME_A) == hashSymbolName(COLLIDING_NAME_B));
+
+    SymbolSnapshot snapshot;
+    snapshot.addSymbol("x", ET_INTEGER, EU_VARIABLE, 0);
+    assert(snapshot.addSymbol(COLLIDING_NAME_A, ET_INTEGER, EU_CONSTANT, "a"));
+    assert(snapshot.addSymbol(COLLIDING_NAME_B, ET_INTEGER, EU_CONSTANT, "b"));
+    assert(!strcmp(snapshot.findSymbol(COLLIDING_NAME_A).constData(), "a"));
+    assert(!strcmp(snapshot.findSymbol(COLLIDING_NAME_B).constData(), "b"));
+
+    SymbolSnapshot fork(snapshot);
+    fork.removeSymbol(COLLIDING_NAME_A);
+    assert(fork.findSymbol(COLLIDING_NAME_A).isNull());
+    assert(!strcmp(fork.findSymbol(COLLIDING_NAME_B).constData(), "b"));
+    assert(!snapshot.findSymbol(COLLIDING_NAME_A).isNull());
+    assert(!fork.findSymbol("x").isNull());
+}
+
+/*!
+ * \brief   Tests that a table sees its base symbols as global ones, may shadow
+ *          them in inner scopes, and removes them without changing the base.
+ */
+void TestSymbolSnapshot::test_symbolTable_onBase_findsShadowsAndRemoves()
+{
+    SymbolSnapshot base;
+    base.addSymbol("int", ET_VOID, EU_KEYWORD, 0);
+    base.addSymbol("DEBUG", ET_VOID, EU_MACRO, "1");
+
+    SymbolTable st(base);
+    assert(st.findSymbol("int").use() == EU_KEYWORD);
+    assert(!st.addSymbol("DEBUG", ET_VOID, EU_MACRO, "2"));
+
+    st.pushScope();
+    assert(st.addSymbol("DEBUG", ET_INTEGER, EU_VARIABLE, "local"));
+    assert(!strcmp(st.findSymbol("DEBUG").constData(), "local"));
+    st.popScope();
+    assert(!strcmp(st.findSymbol("DEBUG").constData(), "1"));
+
+    st.removeSymbol("DEBUG");
+    assert(st.findSymbol("DEBUG").isNull());
+    assert(!base.findSymbol("DEBUG").isNull());
+    assert(st.addSymbol("DEBUG", ET_VOID, EU_MACRO, "0"));
+    assert(!strcmp(st.findSymbol("DEBUG").constData(), "0"));
+}
+
+/*!
+ * \brief   Tests that a table's snapshot holds its base plus the innermost
+ *          symbol of every name, and can seed another table.
+ */
+void TestSymbolSnapshot::test_snapshot_ofTable_capturesVisibleSymbols()
+{
+    SymbolSnapshot base;
+    base.addSymbol("while", ET_VOID, EU_KEYWORD, 0);
+
+    SymbolTable st(base);
+    st.addSymbol("x", ET_INTEGER, EU_VARIABLE, "outer");
+    st.pushScope();
+    st.addSymbol("x", ET_INTEGER, EU_VARIABLE, "inner");
+
+    SymbolSnapshot captured = st.snapshot();
+    assert(captured.size() == 2);
+    assert(!strcmp(captured.findSymbol("x").constData(), "inner"));
+
+    SymbolTable branch(captured);
+    assert(!branch.findSymbol("while").isNull());
+    assert(!strcmp(branch.findSymbol("x").constData(), "inner"));
+}
@@ -0,0 +1,28 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_symbolsnapshot.h
+ *
+ * \brief       Declares the test procedures for the SymbolSnapshot class.
+ */
+#ifndef TEST_SYMBOLSNAPSHOT_H
+#define TEST_SYMBOLSNAPSHOT_H
+
+/*!
+ * \brief   The TestSymbolSnapshot class is a container of test procedures for
+ *          ensuring snapshots share state until written, and that symbol
+ *          tables built on them see their symbols.
+ */
+class TestSymbolSnapshot
+{
+public:
+    void test_addSymbol_manySymbols_allFound();
+    void test_copy_thenWrite_originalUnchanged();
+    void test_removeSymbol_collidingNames_otherKept();
+    void test_symbolTable_onBase_findsShadowsAndRemoves();
+    void test_snapshot_ofTable_capturesVisibleSymbols();
+};
+
+#endif // TEST_SYMBOLSNAPSHOT_H
@@ -9,9 +9,17 @@
  */
 #include <assert.h>
 #include <string.h>
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include "test_symboltable.h"
 #include "../src/symboltable.h"
 #include "../src/symbol.h"
+#include "../src/keywords.h"
+#include "../src/symbolarena.h"
+#include "../src/epochreclaimer.h"
+#include "../src/symbolfilter.h"
 
 ///Scope tests
 /*!
@@ -79,6 +87,80 @@ void TestSymbolTable::test_addSymbol_differentScopes_allowed()
     assert(test1 != test2);
 }
 
+/*!
+ * \brief   Tests that every one of many symbols added to a scope can be found,
+ *          as the scope's table grows.
+ */
+void TestSymbolTable::test_addSymbol_manySymbols_allFound()
+{
+    SymbolTable st;
+    char name[16];
+    for (int i = 0; i < 5000; i++)
+    {
+        snprintf(name, sizeof(name), "sym%d", i);
+        assert(st.addSymbol(name, ET_INTEGER, EU_VARIABLE, 0));
+    }
+
+    for (int i = 0; i < 5000; i++)
+    {
+        snprintf(name, sizeof(name), "sym%d", i);
+        SymbolPtr symbol = st.findSymbol(name);
+        assert(!symbol.isNull());
+        assert(!strcmp(symbol.name(), name));
+    }
+    assert(st.findSymbol("sym5000").isNull());
+}
+
+
+/// Tests that the keyword table is added whole, and found by its perfect hash
+void TestSymbolTable::test_addSymbols_keywords_allFound()
+{
+    SymbolTable st;
+    assert(st.addSymbols(LLC_KEYWORDS, LLC_KEYWORD_COUNT) == LLC_KEYWORD_COUNT);
+
+    for (int i = 0; i < LLC_KEYWORD_COUNT; i++)
+    {
+        SymbolPtr symbol = st.findSymbol(LLC_KEYWORDS[i].m_pName);
+        assert(!symbol.isNull());
+        assert(symbol.use() == EU_KEYWORD);
+        assert(!strcmp(symbol.name(), LLC_KEYWORDS[i].m_pName));
+        assert(findKeyword(LLC_KEYWORDS[i].m_pName) == &LLC_KEYWORDS[i]);
+    }
+
+    assert(!findKeyword(""));
+    assert(!findKeyword("x"));
+    assert(!findKeyword("iff"));
+    assert(!findKeyword("While"));
+    assert(!findKeyword("main"));
+}
+
+/// Tests that names taken in the scope, or earlier in the batch, are skipped
+void TestSymbolTable::test_addSymbols_duplicateNames_skipped()
+{
+    SymbolTable st;
+    assert(st.addSymbol("a", ET_INTEGER, EU_VARIABLE, 0));
+
+    const SymbolDefinition symbols[] =
+    {
+        { "a", ET_CHAR, EU_VARIABLE, 0 },
+        { "b", ET_CHAR, EU_CONSTANT, "12" },
+        { "b", ET_LONG, EU_CONSTANT, "34" },
+        { "c", ET_VOID, EU_FUNCTION, 0 }
+    };
+    assert(st.addSymbols(symbols, 4) == 2);
+    assert(st.findSymbol("a").type() == ET_INTEGER);
+    assert(!strcmp(st.findSymbol("b").constData(), "12"));
+    assert(st.findSymbol("c").use() == EU_FUNCTION);
+
+    // A new scope may shadow every name again
+    st.pushScope();
+    assert(st.addSymbols(symbols, 4) == 3);
+    assert(st.findSymbol("a").type() == ET_CHAR);
+    st.popScope();
+    assert(st.findSymbol("a").type() == ET_INTEGER);
+    assert(!strcmp(st.findSymbol("b").constData(), "12"));
+}
+
 
 ///Symbol removal tests
 /*!
@@ -146,6 +228,39 @@ void TestSymbolTable::test_removeSymbol_fromScope2_reusedSymbolName()
     assert(temp1 == temp2);
 }
 
+/*!
+ * \brief   Tests that symbols repeatedly removed and re-added, as with
+ *          #define and #undef, are found only while defined.
+ */
+void TestSymbolTable::test_removeSymbol_manyTimes_readdFound()
+{
+    SymbolTable st;
+    char name[16];
+    for (int round = 0; round < 20; round++)
+    {
+        for (int i = 0; i < 100; i++)
+        {
+            snprintf(name, sizeof(name), "m%d", i);
+            assert(st.addSymbol(name, ET_VOID, EU_MACRO, "1"));
+        }
+        for (int i = 0; i < 100; i += 2)
+        {
+            snprintf(name, sizeof(name), "m%d", i);
+            st.removeSymbol(name);
+        }
+        for (int i = 0; i < 100; i++)
+        {
+            snprintf(name, sizeof(name), "m%d", i);
+            assert(st.findSymbol(name).isNull() == (i % 2 == 0));
+        }
+        for (int i = 1; i < 100; i += 2)
+        {
+            snprintf(name, sizeof(name), "m%d", i);
+            st.removeSymbol(name);
+        }
+    }
+}
+
 
 ///Symbol search tests
 /*!
@@ -188,3 +303,356 @@ void TestSymbolTable::test_findSymbol_differentScopes_notEqual()
 
     assert(test1 != test2);
 }
+
+/*!
+ * \brief   Tests that each popped scope uncovers the symbol it shadowed, and
+ *          that removing the innermost symbol uncovers the next one out.
+ */
+void TestSymbolTable::test_findSymbol_deepScopes_popRestoresShadowed()
+{
+    SymbolTable st;
+    char data[16];
+    st.addSymbol("outer", ET_INTEGER, EU_VARIABLE, "outer");
+    for (int i = 0; i < 50; i++)
+    {
+        st.pushScope();
+        snprintf(data, sizeof(data), "%d", i);
+        assert(st.addSymbol("x", ET_INTEGER, EU_VARIABLE, data));
+    }
+
+    assert(!strcmp(st.findSymbol("x").constData(), "49"));
+    assert(!strcmp(st.findSymbol("outer").constData(), "outer"));
+
+    st.removeSymbol("x");
+    assert(!strcmp(st.findSymbol("x").constData(), "48"));
+    assert(st.addSymbol("x", ET_INTEGER, EU_VARIABLE, "again"));
+    assert(!strcmp(st.findSymbol("x").constData(), "again"));
+
+    for (int i = 48; i >= 0; i--)
+    {
+        st.popScope();
+        snprintf(data, sizeof(data), "%d", i);
+        assert(!strcmp(st.findSymbol("x").constData(), data));
+    }
+
+    st.popScope();
+    assert(st.findSymbol("x").isNull());
+    assert(!strcmp(st.findSymbol("outer").constData(), "outer"));
+}
+
+/// Tests that a batch lookup, longer than one prefetch batch, returns what
+/// single lookups would, in order
+void TestSymbolTable::test_findSymbols_batch_matchesFindSymbol()
+{
+    SymbolTable st;
+    char names[40][16];
+    const char *batch[40];
+    for (int i = 0; i < 40; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "sym%d", i);
+        batch[i] = names[i];
+        if (i % 3 == 0)
+            assert(st.addSymbol(names[i], ET_INTEGER, EU_VARIABLE, 0));
+    }
+    st.pushScope();
+    assert(st.addSymbol("sym3", ET_CHAR, EU_VARIABLE, 0));
+
+    std::vector<SymbolPtr> symbols;
+    st.findSymbols(batch, 40, symbols);
+    assert(symbols.size() == 40);
+    for (int i = 0; i < 40; i++)
+        assert(symbols[i] == st.findSymbol(names[i]));
+    assert(symbols[3].type() == ET_CHAR);
+    assert(symbols[4].isNull());
+
+    // Results are appended after what the vector already holds
+    st.findSymbols(batch, 1, symbols);
+    assert(symbols.size() == 41 && symbols[40] == symbols[0]);
+}
+
+
+///Arena tests
+/*!
+ * \brief   Tests that pushing and popping scopes full of symbols, which rewinds
+ *          the arena over and over, leaves outer symbols and strings intact.
+ */
+void TestSymbolTable::test_popScope_manyCycles_outerSymbolsIntact()
+{
+    SymbolTable st;
+    char name[16];
+    st.addSymbol("kept", ET_INTEGER, EU_CONSTANT, "42");
+    for (int round = 0; round < 100; round++)
+    {
+        st.pushScope();
+        for (int i = 0; i < 200; i++)
+        {
+            snprintf(name, sizeof(name), "local%d", i);
+            assert(st.addSymbol(name, ET_INTEGER, EU_VARIABLE, name));
+        }
+        assert(!strcmp(st.findSymbol("local199").constData(), "local199"));
+        st.popScope();
+        assert(st.findSymbol("local0").isNull());
+    }
+
+    assert(!strcmp(st.findSymbol("kept").constData(), "42"));
+    assert(st.scope() == 1);
+}
+
+/*!
+ * \brief   Tests that memory released by a rewind is handed out again, and that
+ *          an allocation larger than a chunk still succeeds.
+ */
+void TestSymbolTable::test_arena_rewind_reusesMemory()
+{
+    SymbolArena arena;
+    char *kept = arena.copyString("kept");
+    SymbolArena::Mark mark = arena.mark();
+
+    void *first = arena.allocate(32);
+    arena.rewind(mark);
+    assert(arena.allocate(32) == first);
+
+    char *large = static_cast<char*>(arena.allocate(1 << 20));
+    memset(large, 'x', 1 << 20);
+    arena.rewind(mark);
+    assert(arena.allocate(32) == first);
+    assert(!strcmp(kept, "kept"));
+}
+
+/*!
+ * \brief   Tests that a released block is reused for the same size, and that a
+ *          rewind forgets the released blocks past its mark.
+ */
+void TestSymbolTable::test_arena_releaseThenRewind_dropsLaterBlocks()
+{
+    SymbolArena arena;
+    void *before = arena.allocate(32);
+    SymbolArena::Mark mark = arena.mark();
+    void *after = arena.allocate(32);
+
+    arena.release(before, 32);
+    assert(arena.reuse(32) == before);
+    assert(arena.reuse(64) != before);
+
+    arena.release(before, 32);
+    arena.release(after, 32);
+    arena.rewind(mark);
+    assert(arena.reuse(32) == before);
+    assert(arena.reuse(32) == after);
+    assert(arena.size() == 64);
+}
+
+/*!
+ * \brief   Tests that defining and undefining macros in the global scope, over
+ *          and over, recycles their memory instead of growing the table, while
+ *          scopes pushed and popped between keep working.
+ */
+void TestSymbolTable::test_removeSymbol_defineUndefLoop_memoryBounded()
+{
+    SymbolTable st;
+    st.addSymbols(LLC_KEYWORDS, LLC_KEYWORD_COUNT);
+    size_t usage = 0;
+
+    for (int i = 0; i < 10000; i++)
+    {
+        if (i == 1)
+            usage = st.memoryUsage();
+
+        assert(st.addSymbol("GUARDH", ET_VOID, EU_MACRO, 0));
+        assert(st.addSymbol("X", ET_VOID, EU_CONSTANT, "42"));
+        st.pushScope();
+        assert(st.addSymbol("local", ET_INTEGER, EU_VARIABLE, 0));
+        st.popScope();
+        assert(!strcmp(st.findSymbol("X").constData(), "42"));
+        st.removeSymbol("X");
+        st.removeSymbol("GUARDH");
+        assert(st.findSymbol("X").isNull());
+    }
+    assert(st.memoryUsage() == usage);
+
+    // Keywords share the block of their batch, which is never recycled
+    st.removeSymbol("int");
+    assert(st.addSymbol("X", ET_VOID, EU_CONSTANT, "42"));
+    assert(st.findSymbol("int").isNull());
+    assert(st.findSymbol("while").use() == EU_KEYWORD);
+}
+
+
+
+///Filter tests
+/*!
+ * \brief   Tests that the filter keeps every added hash through removals of
+ *          others and a rebuild, and rejects most hashes never added.
+ */
+void TestSymbolTable::test_filter_addedNames_neverRejected()
+{
+    SymbolFilter filter;
+    assert(!filter.mayContain(hashSymbolName("anything")));
+
+    char name[16];
+    std::vector<unsigned int> hashes;
+    for (int i = 0; i < 100; i++)
+    {
+        snprintf(name, sizeof(name), "f%d", i);
+        filter.add(hashSymbolName(name));
+        hashes.push_back(hashSymbolName(name));
+    }
+    for (int i = 0; i < 100; i += 2)
+    {
+        snprintf(name, sizeof(name), "f%d", i);
+        filter.remove(hashSymbolName(name));
+    }
+    for (int i = 1; i < 100; i += 2)
+    {
+        snprintf(name, sizeof(name), "f%d", i);
+        assert(filter.mayContain(hashSymbolName(name)));
+    }
+
+    filter.rebuild(hashes, false);
+    int rejected = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        snprintf(name, sizeof(name), "miss%d", i);
+        if (!filter.mayContain(hashSymbolName(name)))
+            rejected++;
+    }
+    for (size_t i = 0; i < hashes.size(); i++)
+        assert(filter.mayContain(hashes[i]));
+    assert(rejected > 900);
+}
+
+/*!
+ * \brief   Tests that declared names are found across filter rebuilds, scope
+ *          pops and removals, while undeclared ones miss.
+ */
+void TestSymbolTable::test_findSymbol_manyMisses_stillFindsDeclared()
+{
+    SymbolTable st;
+    char name[16];
+    for (int i = 0; i < 500; i++)
+    {
+        snprintf(name, sizeof(name), "g%d", i);
+        st.addSymbol(name, ET_INTEGER, EU_VARIABLE, 0);
+    }
+
+    st.pushScope();
+    st.addSymbol("g1", ET_INTEGER, EU_VARIABLE, "inner");
+    st.addSymbol("local", ET_INTEGER, EU_VARIABLE, 0);
+    st.popScope();
+    st.removeSymbol("g2");
+
+    for (int i = 0; i < 500; i++)
+    {
+        snprintf(name, sizeof(name), "g%d", i);
+        assert(st.findSymbol(name).isNull() == (i == 2));
+        snprintf(name, sizeof(name), "h%d", i);
+        assert(st.findSymbol(name).isNull());
+    }
+    assert(st.findSymbol("g1").constData() == 0);
+    assert(st.findSymbol("local").isNull());
+}
+
+
+///Statistics tests
+/*!
+ * \brief   Tests that adds, lookups and scope changes are counted, lookups by
+ *          the depth they were made at, and that the dumps include them.
+ */
+void TestSymbolTable::test_stats_enabled_countsOperationsByDepth()
+{
+    SymbolTable st;
+    st.setStatsEnabled(true);
+    st.addSymbol("x", ET_INTEGER, EU_VARIABLE, 0);
+    st.addSymbol("x", ET_INTEGER, EU_VARIABLE, 0);
+    st.findSymbol("x");
+    st.findSymbol("missing");
+
+    st.pushScope();
+    st.pushScope();
+    st.findSymbol("x");
+    st.popScope();
+    st.removeSymbol("x");
+
+    const SymbolTableStats *stats = st.stats();
+    assert(stats->adds() == 1 && stats->addConflicts() == 1);
+    assert(stats->finds() == 3 && stats->hits() == 2 && stats->misses() == 1);
+    assert(stats->findsAtDepth(1) == 2 && stats->hitsAtDepth(1) == 1);
+    assert(stats->findsAtDepth(3) == 1 && stats->hitsAtDepth(3) == 1);
+    assert(stats->removes() == 1);
+    assert(stats->pushes() == 2 && stats->pops() == 1 && stats->maxDepth() == 3);
+    assert(stats->maxProbeLength() >= 1);
+
+    std::string json = stats->toJson();
+    assert(json.find("\"finds\":3") != std::string::npos);
+    assert(json.find("{\"depth\":3,\"finds\":1,\"hits\":1") != std::string::npos);
+    assert(stats->toText().find("max depth 3") != std::string::npos);
+}
+
+/*!
+ * \brief   Tests that statistics are off by default and can be turned off.
+ */
+void TestSymbolTable::test_stats_disabled_isNull()
+{
+    SymbolTable st;
+    assert(!st.stats());
+    st.setStatsEnabled(true);
+    assert(st.stats());
+    st.setStatsEnabled(false);
+    assert(!st.stats());
+    assert(st.addSymbol("x", ET_INTEGER, EU_VARIABLE, 0));
+}
+
+///Concurrency tests
+/*!
+ * \brief   Tests that readers on several threads always find the global
+ *          symbols, while a writer pushes and pops scopes, grows the name
+ *          table and shadows a global.
+ */
+void TestSymbolTable::test_findSymbol_concurrentReaders_seeStableSymbols()
+{
+    SymbolTable st;
+    st.setConcurrent(true);
+    st.addSymbol("while", ET_VOID, EU_KEYWORD, 0);
+    st.addSymbol("shared", ET_INTEGER, EU_CONSTANT, "global");
+
+    std::atomic<bool> done(false);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++)
+    {
+        readers.push_back(std::thread([&]()
+        {
+            while (!done.load())
+            {
+                if (st.findSymbol("while").isNull())
+                    failures++;
+
+                EpochReclaimer::ReadSection section;
+                SymbolPtr shared = st.findSymbol("shared");
+                if (shared.isNull() || (strcmp(shared.constData(), "global") &&
+                                        strcmp(shared.constData(), "local")))
+                    failures++;
+            }
+        }));
+    }
+
+    char name[16];
+    for (int round = 0; round < 50; round++)
+    {
+        st.pushScope();
+        st.addSymbol("shared", ET_INTEGER, EU_CONSTANT, "local");
+        for (int i = 0; i < 100; i++)
+        {
+            snprintf(name, sizeof(name), "r%d_%d", round, i);
+            st.addSymbol(name, ET_INTEGER, EU_VARIABLE, name);
+        }
+        st.popScope();
+    }
+
+    done = true;
+    for (size_t i = 0; i < readers.size(); i++)
+        readers[i].join();
+
+    assert(failures == 0);
+    assert(!strcmp(st.findSymbol("shared").constData(), "global"));
+}
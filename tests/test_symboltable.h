@@ -26,16 +26,39 @@ public:
     void test_addSymbol_atGlobal_newSymbol();
     void test_addSymbol_atGlobal_duplicateSymbolName();
     void test_addSymbol_differentScopes_allowed();
+    void test_addSymbol_manySymbols_allFound();
+    void test_addSymbols_keywords_allFound();
+    void test_addSymbols_duplicateNames_skipped();
 
     /// Symbol removal tests
     void test_removeSymbol_fromGlobalScope();
     void test_removeSymbol_fromGlobalScope_atDifferentScope();
     void test_removeSymbol_fromScope2_reusedSymbolName();
+    void test_removeSymbol_manyTimes_readdFound();
 
     /// Symbol retrieval tests
     void test_findSymbol_atGlobal_succeeds();
     void test_findSymbol_atGlobal_undeclaredSymbol();
     void test_findSymbol_differentScopes_notEqual();
+    void test_findSymbol_deepScopes_popRestoresShadowed();
+    void test_findSymbols_batch_matchesFindSymbol();
+
+    /// Arena tests
+    void test_popScope_manyCycles_outerSymbolsIntact();
+    void test_arena_rewind_reusesMemory();
+    void test_arena_releaseThenRewind_dropsLaterBlocks();
+    void test_removeSymbol_defineUndefLoop_memoryBounded();
+
+    /// Filter tests
+    void test_filter_addedNames_neverRejected();
+    void test_findSymbol_manyMisses_stillFindsDeclared();
+
+    /// Statistics tests
+    void test_stats_enabled_countsOperationsByDepth();
+    void test_stats_disabled_isNull();
+
+    /// Concurrency tests
+    void test_findSymbol_concurrentReaders_seeStableSymbols();
 
 };
 
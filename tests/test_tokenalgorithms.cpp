@@ -0,0 +1,105 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_tokenalgorithms.cpp
+ *
+ * \brief       Defines the test procedures declared in test_tokenalgorithms.h
+ */
+#include <assert.h>
+#include <stdio.h>
+#include "test_tokenalgorithms.h"
+#include "../src/tokenalgorithms.h"
+
+/// Enough tokens to be split across several chunks.
+#define TEST_TOKEN_COUNT    (PARALLEL_MIN_CHUNK * 8 + 3)
+
+/// Fills a list with alternating ID and CONSTANT tokens numbered in order.
+static void fillTokens(TokenList &tokens)
+{
+    char lexeme[16];
+    for (int i = 0; i < TEST_TOKEN_COUNT; i++)
+    {
+        snprintf(lexeme, sizeof(lexeme), "%d", i);
+        tokens.add(new Token(lexeme, i % 2 ? "CONSTANT" : "ID"));
+    }
+}
+
+/// Deletes the tokens of a list; the list only frees its nodes.
+static void deleteTokens(TokenList &tokens)
+{
+    for (TokenList::iterator it = tokens.begin(); it != tokens.end(); ++it)
+        delete *it;
+}
+
+/*!
+ * \brief   Tests that transforming replaces each ID token in its own position.
+ */
+void TestTokenAlgorithms::test_parallelTransform_largeList_replacesInOrder()
+{
+    ThreadPool pool(4);
+    TokenList tokens;
+    fillTokens(tokens);
+
+    parallelTransform(tokens, [](Token *token) {
+        return token->type() == "ID" ? new Token(token->lexeme(), "MACRO") : token;
+    }, pool);
+
+    int i = 0;
+    char lexeme[16];
+    for (TokenList::iterator it = tokens.begin(); it != tokens.end(); ++it, i++)
+    {
+        snprintf(lexeme, sizeof(lexeme), "%d", i);
+        assert((*it)->lexeme() == lexeme);
+        assert((*it)->type() == (i % 2 ? "CONSTANT" : "MACRO"));
+    }
+    assert(i == TEST_TOKEN_COUNT);
+
+    deleteTokens(tokens);
+}
+
+/*!
+ * \brief   Tests that filtering keeps the surviving tokens in order.
+ */
+void TestTokenAlgorithms::test_parallelFilter_largeList_keepsOrder()
+{
+    ThreadPool pool(4);
+    TokenList tokens;
+    fillTokens(tokens);
+
+    int removed = parallelFilter(tokens, [](Token *token) {
+        return token->type() == "CONSTANT";
+    }, pool);
+    assert(removed == TEST_TOKEN_COUNT / 2 + 1);
+    assert(tokens.length() == TEST_TOKEN_COUNT / 2);
+
+    int i = 1;
+    char lexeme[16];
+    for (TokenList::iterator it = tokens.begin(); it != tokens.end(); ++it, i += 2)
+    {
+        snprintf(lexeme, sizeof(lexeme), "%d", i);
+        assert((*it)->lexeme() == lexeme);
+    }
+
+    deleteTokens(tokens);
+}
+
+/*!
+ * \brief   Tests that counting across chunks matches the serial count.
+ */
+void TestTokenAlgorithms::test_parallelCountIf_largeList_countsAll()
+{
+    ThreadPool pool(4);
+    TokenList tokens;
+    fillTokens(tokens);
+
+    assert(parallelCountIf(tokens, [](Token *token) {
+        return token->type() == "ID";
+    }, pool) == TEST_TOKEN_COUNT / 2 + 1);
+
+    TokenList empty;
+    assert(parallelCountIf(empty, [](Token *) { return true; }, pool) == 0);
+
+    deleteTokens(tokens);
+}
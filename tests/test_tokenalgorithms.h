@@ -0,0 +1,25 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_tokenalgorithms.h
+ *
+ * \brief       Declares the test procedures for the parallel token algorithms.
+ */
+#ifndef TEST_TOKENALGORITHMS_H
+#define TEST_TOKENALGORITHMS_H
+
+/*!
+ * \brief   The TestTokenAlgorithms class is a container of test procedures for
+ *          ensuring the parallel token algorithms match their serial results.
+ */
+class TestTokenAlgorithms
+{
+public:
+    void test_parallelTransform_largeList_replacesInOrder();
+    void test_parallelFilter_largeList_keepsOrder();
+    void test_parallelCountIf_largeList_countsAll();
+};
+
+#endif // TEST_TOKENALGORITHMS_H
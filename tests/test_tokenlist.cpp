@@ -0,0 +1,335 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_tokenlist.cpp
+ *
+ * \brief       Defines the test procedures declared in test_tokenlist.h
+ */
+#include <assert.h>
+#include <algorithm>
+#include "test_tokenlist.h"
+#include "../src/token.h"
+#include "../src/tokenlist.h"
+#include "../src/tokenindex.h"
+
+/// Deletes the tokens of a list; the list only frees its nodes.
+static void deleteTokens(TokenList &tokens)
+{
+    for (TokenList::iterator it = tokens.begin(); it != tokens.end(); ++it)
+        delete *it;
+}
+
+///Iterator tests
+/*!
+ * \brief   Tests that iterating a list visits every token in order.
+ */
+void TestTokenList::test_iterator_forward_visitsInOrder()
+{
+    TokenList tokens;
+    tokens.add(new Token("a", "ID"));
+    tokens.add(new Token("=", "ASSIGNOP"));
+    tokens.add(new Token("1", "CONSTANT"));
+
+    const char *expected[] = { "a", "=", "1" };
+    int i = 0;
+    for (TokenList::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+        assert((*it)->lexeme() == expected[i++]);
+    assert(i == 3);
+    assert(std::distance(tokens.begin(), tokens.end()) == tokens.length());
+
+    deleteTokens(tokens);
+}
+
+/*!
+ * \brief   Tests that stepping back from the end yields the last token.
+ */
+void TestTokenList::test_iterator_decrementEnd_lastToken()
+{
+    TokenList tokens;
+    tokens.add(new Token("a", "ID"));
+    tokens.add(new Token("b", "ID"));
+
+    TokenList::iterator it = tokens.end();
+    --it;
+    assert((*it)->lexeme() == "b");
+    --it;
+    assert(it == tokens.begin());
+
+    deleteTokens(tokens);
+}
+
+
+///Cursor tests
+/*!
+ * \brief   Tests that erasing at the cursor returns the token and moves to the
+ *          token which followed it.
+ */
+void TestTokenList::test_cursor_erase_advancesToNext()
+{
+    TokenList tokens;
+    tokens.add(new Token("a", "ID"));
+    tokens.add(new Token("b", "ID"));
+
+    TokenCursor cursor(tokens);
+    Token *erased = cursor.erase();
+    assert(erased->lexeme() == "a");
+    assert(cursor.token()->lexeme() == "b");
+    assert(tokens.length() == 1);
+    delete erased;
+
+    delete cursor.erase();
+    assert(cursor.atEnd());
+    assert(tokens.length() == 0);
+    assert(tokens.begin() == tokens.end());
+}
+
+/*!
+ * \brief   Tests that inserting before the head and before the end updates
+ *          both ends of the list.
+ */
+void TestTokenList::test_cursor_insertBefore_atHeadAndEnd()
+{
+    TokenList tokens;
+    tokens.add(new Token("b", "ID"));
+
+    TokenCursor cursor(tokens);
+    cursor.insertBefore(new Token("a", "ID"));
+    assert((*tokens.begin())->lexeme() == "a");
+
+    cursor.next();
+    assert(cursor.atEnd());
+    cursor.insertBefore(new Token("c", "ID"));
+    assert((*--tokens.end())->lexeme() == "c");
+    assert(tokens.length() == 3);
+
+    deleteTokens(tokens);
+}
+
+/*!
+ * \brief   Tests that inserting after the tail token appends to the list.
+ */
+void TestTokenList::test_cursor_insertAfter_atTail()
+{
+    TokenList tokens;
+    tokens.add(new Token("a", "ID"));
+
+    TokenCursor cursor(tokens);
+    cursor.insertAfter(new Token("b", "ID"));
+    assert(cursor.token()->lexeme() == "a");
+    assert((*--tokens.end())->lexeme() == "b");
+    assert(tokens.length() == 2);
+
+    deleteTokens(tokens);
+}
+
+
+///Node handle tests
+/*!
+ * \brief   Tests that splicing before a node handle inserts the source list in
+ *          place and empties the source list.
+ */
+void TestTokenList::test_splice_beforeNode_insertsInPlace()
+{
+    TokenList tokens, included;
+    tokens.add(new Token("a", "ID"));
+    TokenNode *d = tokens.add(new Token("d", "ID"));
+    included.add(new Token("b", "ID"));
+    included.add(new Token("c", "ID"));
+
+    tokens.splice(d, included);
+    assert(tokens.length() == 4);
+    assert(included.length() == 0);
+    assert(included.begin() == included.end());
+
+    const char *expected[] = { "a", "b", "c", "d" };
+    int i = 0;
+    for (TokenList::iterator it = tokens.begin(); it != tokens.end(); ++it)
+        assert((*it)->lexeme() == expected[i++]);
+    assert((*--tokens.end())->lexeme() == "d");
+
+    deleteTokens(tokens);
+}
+
+/*!
+ * \brief   Tests that moving a list with no before token appends it.
+ */
+void TestTokenList::test_move_nullBefore_appends()
+{
+    TokenList tokens, included;
+    tokens.add(new Token("a", "ID"));
+    included.add(new Token("b", "ID"));
+
+    included.move(&tokens);
+    assert(tokens.length() == 2);
+    assert((*--tokens.end())->lexeme() == "b");
+    assert(included.length() == 0);
+
+    deleteTokens(tokens);
+}
+
+/*!
+ * \brief   Tests that removing by node handle unlinks only that node.
+ */
+void TestTokenList::test_remove_byNode_unlinksNode()
+{
+    TokenList tokens;
+    Token *a = new Token("a", "ID"), *b = new Token("b", "ID");
+    tokens.add(a);
+    TokenNode *bNode = tokens.add(b);
+    tokens.insertAfter(new Token("c", "ID"), bNode);
+
+    tokens.remove(bNode);
+    delete b;
+    assert(tokens.length() == 2);
+    assert(*tokens.begin() == a);
+    assert((*++tokens.begin())->lexeme() == "c");
+
+    deleteTokens(tokens);
+}
+
+
+
+///Range erase tests
+/*!
+ * \brief   Tests that erasing a range in the middle of the list joins the
+ *          tokens on either side of it.
+ */
+void TestTokenList::test_erase_midRange_joinsNeighbours()
+{
+    TokenList tokens;
+    tokens.add(new Token("a", "ID"));
+    TokenNode *b = tokens.add(new Token("b", "ID"));
+    tokens.add(new Token("c", "ID"));
+    TokenNode *d = tokens.add(new Token("d", "ID"));
+
+    assert(tokens.erase(b, d) == 2);
+    assert(tokens.length() == 2);
+    assert((*tokens.begin())->lexeme() == "a");
+    assert((*++tokens.begin())->lexeme() == "d");
+    assert((*--tokens.end())->lexeme() == "d");
+
+    // Erased nodes are reused
+    TokenNode *e = tokens.add(new Token("e", "ID"));
+    assert(e == b);
+
+    deleteTokens(tokens);
+}
+
+/*!
+ * \brief   Tests that erasing through the end of the list, including from the
+ *          head, leaves the list consistent.
+ */
+void TestTokenList::test_erase_toEnd_updatesTail()
+{
+    TokenList tokens;
+    tokens.add(new Token("a", "ID"));
+    tokens.add(new Token("b", "ID"));
+    tokens.add(new Token("c", "ID"));
+
+    TokenList::iterator b = ++tokens.begin();
+    assert(tokens.erase(b, tokens.end()) == tokens.end());
+    assert(tokens.length() == 1);
+    assert((*--tokens.end())->lexeme() == "a");
+
+    TokenCursor cursor(tokens);
+    assert(cursor.eraseUntil(0) == 1);
+    assert(cursor.atEnd());
+    assert(tokens.length() == 0);
+    assert(tokens.begin() == tokens.end());
+}
+
+
+///Index tests
+/*!
+ * \brief   Tests that the index, once built, follows insertions, removals and
+ *          range erases.
+ */
+void TestTokenList::test_index_afterEdits_tracksTypesAndIdentifiers()
+{
+    TokenList tokens;
+    tokens.add(new Token("#define", "PREPROCESSOR"));
+    TokenNode *x = tokens.add(new Token("x", "ID"));
+    tokens.add(new Token("1", "CONSTANT"));
+
+    assert(tokens.index().ofType("PREPROCESSOR").size() == 1);
+    assert(tokens.index().ofIdentifier("x").count(x) == 1);
+    assert(tokens.index().ofType("STRING").empty());
+
+    TokenNode *x2 = tokens.insertAfter(new Token("x", "ID"), x);
+    assert(tokens.index().ofIdentifier("x").size() == 2);
+    assert(tokens.index().ofType("ID").count(x2) == 1);
+
+    Token *token = x->token();
+    tokens.remove(x);
+    delete token;
+    assert(tokens.index().ofIdentifier("x").size() == 1);
+
+    tokens.erase(tokens.begin(), tokens.end());
+    assert(tokens.index().ofIdentifier("x").empty());
+    assert(tokens.index().ofType("PREPROCESSOR").empty());
+}
+
+/*!
+ * \brief   Tests that spliced tokens are found after the index is rebuilt.
+ */
+void TestTokenList::test_index_afterSplice_rebuilt()
+{
+    TokenList tokens, included;
+    tokens.add(new Token("a", "ID"));
+    assert(tokens.index().ofType("STRING").empty());
+
+    included.add(new Token("\"globals.h\"", "STRING"));
+    assert(included.index().ofType("STRING").size() == 1);
+    tokens.splice(0, included);
+
+    assert(tokens.index().ofType("STRING").size() == 1);
+    assert(included.index().ofType("STRING").empty());
+
+    deleteTokens(tokens);
+}
+
+///Node pool tests
+/*!
+ * \brief   Tests that a removed node is reused by the next insertion.
+ */
+void TestTokenList::test_pool_removeThenAdd_reusesNode()
+{
+    TokenList tokens;
+    Token *a = new Token("a", "ID");
+    TokenNode *aNode = tokens.add(a);
+    tokens.remove(aNode);
+    delete a;
+
+    TokenNode *bNode = tokens.add(new Token("b", "ID"));
+    assert(bNode == aNode);
+    assert(tokens.length() == 1);
+
+    deleteTokens(tokens);
+}
+
+/*!
+ * \brief   Tests that nodes spliced out of a list outlive that list, since its
+ *          slabs move with them.
+ */
+void TestTokenList::test_pool_splicedSourceDestroyed_nodesRemainValid()
+{
+    TokenList tokens;
+    tokens.add(new Token("a", "ID"));
+
+    TokenList *included = new TokenList;
+    for (int i = 0; i < 100; i++)
+        included->add(new Token("b", "ID"));
+    tokens.splice(0, *included);
+    delete included;
+
+    int count = 0;
+    for (TokenList::iterator it = tokens.begin(); it != tokens.end(); ++it)
+        count++;
+    assert(count == 101);
+    tokens.add(new Token("c", "ID"));
+    assert((*--tokens.end())->lexeme() == "c");
+
+    deleteTokens(tokens);
+}
@@ -0,0 +1,48 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_tokenlist.h
+ *
+ * \brief       Declares the test procedures for the TokenList class.
+ */
+#ifndef TEST_TOKENLIST_H
+#define TEST_TOKENLIST_H
+
+/*!
+ * \brief   The TestTokenList class is a container of test procedures for
+ *          ensuring the consistency and validity of the token list, its
+ *          iterators and cursors.
+ */
+class TestTokenList
+{
+public:
+    /// Iterator tests
+    void test_iterator_forward_visitsInOrder();
+    void test_iterator_decrementEnd_lastToken();
+
+    /// Cursor tests
+    void test_cursor_erase_advancesToNext();
+    void test_cursor_insertBefore_atHeadAndEnd();
+    void test_cursor_insertAfter_atTail();
+
+    /// Node handle tests
+    void test_splice_beforeNode_insertsInPlace();
+    void test_move_nullBefore_appends();
+    void test_remove_byNode_unlinksNode();
+
+    /// Range erase tests
+    void test_erase_midRange_joinsNeighbours();
+    void test_erase_toEnd_updatesTail();
+
+    /// Index tests
+    void test_index_afterEdits_tracksTypesAndIdentifiers();
+    void test_index_afterSplice_rebuilt();
+
+    /// Node pool tests
+    void test_pool_removeThenAdd_reusesNode();
+    void test_pool_splicedSourceDestroyed_nodesRemainValid();
+};
+
+#endif // TEST_TOKENLIST_H
@@ -0,0 +1,110 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_tokensequence.cpp
+ *
+ * \brief       Defines the test procedures declared in test_tokensequence.h
+ */
+#include <assert.h>
+#include <string>
+#include "test_tokensequence.h"
+#include "../src/token.h"
+#include "../src/tokenlist.h"
+#include "../src/tokensequence.h"
+
+/// Creates a buffer with one ID token per character of \p lexemes.
+static TokenBuffer *makeBuffer(const char *lexemes)
+{
+    TokenList tokens;
+    for (const char *ch = lexemes; *ch; ch++)
+        tokens.add(new Token(std::string(1, *ch), "ID"));
+    return new TokenBuffer(tokens);
+}
+
+/// Joins the lexemes of a sequence into one string.
+static std::string join(TokenSequence &sequence)
+{
+    std::string joined;
+    for (TokenSequence::iterator it = sequence.begin(); it != sequence.end(); ++it)
+        joined += (*it)->lexeme();
+    return joined;
+}
+
+///Insertion tests
+/*!
+ * \brief   Tests that inserting a buffer within a piece splits that piece and
+ *          places the buffer's tokens in order.
+ */
+void TestTokenSequence::test_insert_midPiece_splitsPiece()
+{
+    TokenBuffer *file = makeBuffer("abef"), *header = makeBuffer("cd");
+    TokenSequence sequence;
+    sequence.append(file);
+
+    TokenSequence::iterator pos = sequence.begin();
+    ++pos;
+    ++pos;
+    TokenSequence::iterator first = sequence.insert(pos, header);
+    assert((*first)->lexeme() == "c");
+    assert(join(sequence) == "abcdef");
+    assert(sequence.length() == 6);
+    assert(sequence.pieceCount() == 3);
+
+    TokenSequence::iterator last = sequence.end();
+    --last;
+    assert((*last)->lexeme() == "f");
+
+    file->release();
+    header->release();
+}
+
+/*!
+ * \brief   Tests that inserting a sequence into itself and copying sequences
+ *          share buffers rather than tokens.
+ */
+void TestTokenSequence::test_insert_sequence_sharesBuffers()
+{
+    TokenBuffer *buffer = makeBuffer("ab");
+    TokenSequence sequence;
+    sequence.append(buffer);
+    buffer->release();
+
+    TokenSequence copy(sequence);
+    sequence.insert(sequence.end(), sequence);
+    assert(join(sequence) == "abab");
+    assert(join(copy) == "ab");
+    assert(*sequence.begin() == *copy.begin());
+
+    TokenList tokens;
+    sequence.copyTo(tokens);
+    assert(tokens.length() == 4);
+    for (TokenList::iterator it = tokens.begin(); it != tokens.end(); ++it)
+        delete *it;
+}
+
+
+///Removal tests
+/*!
+ * \brief   Tests that erasing within a piece removes only that token.
+ */
+void TestTokenSequence::test_erase_midPiece_splitsPiece()
+{
+    TokenBuffer *buffer = makeBuffer("abc");
+    TokenSequence sequence;
+    sequence.append(buffer);
+    buffer->release();
+
+    TokenSequence::iterator pos = sequence.begin();
+    ++pos;
+    pos = sequence.erase(pos);
+    assert((*pos)->lexeme() == "c");
+    assert(join(sequence) == "ac");
+    assert(sequence.length() == 2);
+
+    pos = sequence.erase(sequence.begin());
+    pos = sequence.erase(pos);
+    assert(pos == sequence.end());
+    assert(sequence.length() == 0);
+}
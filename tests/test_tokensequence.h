@@ -0,0 +1,28 @@
+/*!
+ * \author      Giancarlo Villanueva
+ * \date        Created, 10/18/2026
+ *              Modified, 10/18/2026
+ * \ingroup     CST320 - Lab1c
+ * \file        test_tokensequence.h
+ *
+ * \brief       Declares the test procedures for the TokenSequence class.
+ */
+#ifndef TEST_TOKENSEQUENCE_H
+#define TEST_TOKENSEQUENCE_H
+
+/*!
+ * \brief   The TestTokenSequence class is a container of test procedures for
+ *          ensuring the consistency and validity of the token piece table.
+ */
+class TestTokenSequence
+{
+public:
+    /// Insertion tests
+    void test_insert_midPiece_splitsPiece();
+    void test_insert_sequence_sharesBuffers();
+
+    /// Removal tests
+    void test_erase_midPiece_splitsPiece();
+};
+
+#endif // TEST_TOKENSEQUENCE_H